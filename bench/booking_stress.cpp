@@ -0,0 +1,189 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include "Scheduler.h"
+#include "JournalTransaction.h"
+#include "Instrumentation.h"
+
+#ifndef _WIN32
+#include <sys/wait.h>   // For waitpid
+#include <unistd.h>     // For fork, pipe, read, write, close
+#endif
+
+// Multi-process booking stress: several processes book (and cancel) the same few days of a clinic
+// through JournalTransaction, as concurrent user_app invocations do. Afterwards the files are loaded
+// again and checked for lost or duplicated appointments and for overlaps on a chair.
+// Prints one JSON object and exits with 1 when the check fails.
+
+typedef std::chrono::steady_clock Clock;
+
+const int STRESS_DAYS = 5;          // Days of 2030 the workers compete for
+const int STRESS_DAY_START = 8 * 60;
+const int STRESS_DAY_END = 18 * 60;
+
+// What one worker reports back to the parent
+struct WorkerResult {
+    uint64_t attempts = 0;
+    uint64_t accepted = 0;
+    uint64_t cancelled = 0;
+    uint64_t journalSyncs = 0;
+    uint64_t syncsShared = 0;
+};
+
+/**
+ * @brief Loads a clinic the way user_app does; false if the catalog is missing.
+ */
+static bool loadClinic(Scheduler& scheduler, const std::string& dir, const std::string& appsFile) {
+    if (!scheduler.loadOperations(dir + "/op_details.txt")) return false;
+    scheduler.loadResources(dir + "/res_details.txt");
+    scheduler.loadAppointments(appsFile);
+    return true;
+}
+
+/**
+ * @brief Books random slots from one long-lived process; its view only catches up inside each transaction.
+ */
+static WorkerResult runWorker(const std::string& dir, const std::string& appsFile, int worker, int bookings, size_t checkpointRecords) {
+    WorkerResult result;
+    Instrumentation::enable();
+    Scheduler scheduler;
+    if (!loadClinic(scheduler, dir, appsFile)) return result;
+    std::mt19937 rng(static_cast<unsigned>(worker) * 7919u + 1u);
+    std::uniform_int_distribution<int> dayDist(1, STRESS_DAYS);
+    std::uniform_int_distribution<int> slotDist(0, (STRESS_DAY_END - STRESS_DAY_START) / 15 - 1);
+    std::uniform_int_distribution<int> opDist(1, static_cast<int>(scheduler.operations.size()));
+    std::uniform_int_distribution<int> actionDist(0, 15);
+    std::ostream discard(nullptr);
+    std::vector<Appointment> mine; // Only a worker's own bookings are cancelled, so none is cancelled twice
+
+    for (int i = 0; i < bookings; ++i) {
+        JournalTransaction transaction(scheduler, appsFile);
+        ++result.attempts;
+        if (!mine.empty() && actionDist(rng) == 0) {
+            size_t pick = std::uniform_int_distribution<size_t>(0, mine.size() - 1)(rng);
+            const Appointment app = mine[pick];
+            int day, month, year;
+            app.date(day, month, year);
+            Appointment previous;
+            if (scheduler.cancelAppointment(day, month, year, app.hour(), app.minute(), app.resourceId, &previous, discard, discard) &&
+                scheduler.appendCancellation(appsFile, previous)) {
+                mine.erase(mine.begin() + pick);
+                ++result.cancelled;
+            }
+        } else {
+            int start = STRESS_DAY_START + slotDist(rng) * 15;
+            Appointment scheduled;
+            if (scheduler.scheduleAppointment(dayDist(rng), 1, 2030, start / 60, start % 60, opDist(rng), &scheduled, discard, discard) &&
+                scheduler.appendAppointment(appsFile, scheduled)) {
+                mine.push_back(scheduled);
+                ++result.accepted;
+            }
+        }
+        if (scheduler.journalSize() >= checkpointRecords) {
+            scheduler.checkpointAppointments(appsFile);
+        }
+    }
+    result.journalSyncs = Instrumentation::value(Counter::JournalSyncs);
+    result.syncsShared = Instrumentation::value(Counter::SyncsShared);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+#ifndef _WIN32
+    if (argc < 2 || argc > 5) {
+        std::cerr << "Usage: ./booking_stress <clinic_dir> [processes=8] [bookings_per_process=200] [checkpoint_records=100]" << std::endl;
+        return 1;
+    }
+    const std::string dir = argv[1];
+    const int processes = argc > 2 ? std::stoi(argv[2]) : 8;
+    const int bookings = argc > 3 ? std::stoi(argv[3]) : 200;
+    const size_t checkpointRecords = argc > 4 ? static_cast<size_t>(std::stoul(argv[4])) : 100;
+    if (processes <= 0 || bookings < 0 || checkpointRecords == 0) {
+        std::cerr << "Error: processes and checkpoint_records must be > 0 and bookings >= 0." << std::endl;
+        return 1;
+    }
+    // A file of its own, so the clinic's appointments are left alone
+    const std::string appsFile = dir + "/stress_app_details.txt";
+    for (const char* suffix : {"", ".journal", ".journal.sync", ".lock", ".bin", ".tmp"}) {
+        std::remove((appsFile + suffix).c_str());
+    }
+
+    Clock::time_point start = Clock::now();
+    std::vector<int> pipes;
+    std::vector<pid_t> children;
+    for (int worker = 0; worker < processes; ++worker) {
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            std::cerr << "Error: could not create a pipe." << std::endl;
+            return 1;
+        }
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            std::cerr << "Error: could not start worker " << worker << "." << std::endl;
+            return 1;
+        }
+        if (pid == 0) {
+            ::close(fds[0]);
+            WorkerResult result = runWorker(dir, appsFile, worker, bookings, checkpointRecords);
+            bool sent = ::write(fds[1], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+            ::close(fds[1]);
+            ::_exit(sent ? 0 : 1);
+        }
+        ::close(fds[1]);
+        pipes.push_back(fds[0]);
+        children.push_back(pid);
+    }
+
+    WorkerResult total;
+    bool workersOk = true;
+    for (size_t i = 0; i < children.size(); ++i) {
+        WorkerResult result;
+        if (::read(pipes[i], &result, sizeof(result)) != static_cast<ssize_t>(sizeof(result))) {
+            workersOk = false;
+        } else {
+            total.attempts += result.attempts;
+            total.accepted += result.accepted;
+            total.cancelled += result.cancelled;
+            total.journalSyncs += result.journalSyncs;
+            total.syncsShared += result.syncsShared;
+        }
+        ::close(pipes[i]);
+        int status = 0;
+        ::waitpid(children[i], &status, 0);
+        workersOk = workersOk && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Every accepted booking that was not cancelled must be on disk, once, without overlapping another on its chair
+    Scheduler check;
+    if (!loadClinic(check, dir, appsFile)) return 1;
+    const uint64_t expected = total.accepted - total.cancelled;
+    const uint64_t stored = check.appointments.size();
+    std::vector<int64_t> busyUntil(check.resources.size(), INT64_MIN);
+    uint64_t overlaps = 0;
+    for (const auto& app : check.appointments) {
+        if (app.start < busyUntil[app.resourceId]) ++overlaps;
+        busyUntil[app.resourceId] = std::max(busyUntil[app.resourceId], app.start + app.duration);
+    }
+    const uint64_t lost = expected > stored ? expected - stored : 0;
+    const uint64_t duplicated = stored > expected ? stored - expected : 0;
+
+    std::printf("{\"op\":\"booking_stress\",\"processes\":%d,\"attempts\":%llu,\"accepted\":%llu,\"cancelled\":%llu,\"stored\":%llu,"
+                "\"lost\":%llu,\"duplicated\":%llu,\"overlaps\":%llu,\"journal_syncs\":%llu,\"syncs_shared\":%llu,\"changes_per_sec\":%.1f}\n",
+                processes, (unsigned long long)total.attempts, (unsigned long long)total.accepted, (unsigned long long)total.cancelled,
+                (unsigned long long)stored, (unsigned long long)lost, (unsigned long long)duplicated, (unsigned long long)overlaps,
+                (unsigned long long)total.journalSyncs, (unsigned long long)total.syncsShared,
+                seconds > 0.0 ? (total.accepted + total.cancelled) / seconds : 0.0);
+    return workersOk && lost == 0 && duplicated == 0 && overlaps == 0 ? 0 : 1;
+#else
+    (void)argc;
+    (void)argv;
+    std::cerr << "booking_stress needs fork and flock, which this platform does not provide." << std::endl;
+    return 1;
+#endif
+}
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <random>
+#include "Calendar.h"
+
+// Generates a synthetic clinic: op_details.txt and app_details.txt in the given directory.
+// Appointments are packed into working hours (08:00-20:00), day after day from 1/1/2024,
+// with a random number of appointments per day around the requested density.
+
+struct GeneratedOperation {
+    const char* name;
+    float price;
+    int duration;
+};
+
+const GeneratedOperation CATALOG[] = {
+    {"Consultation", 75.0f, 30}, {"Cleaning", 200.0f, 60}, {"Filling", 150.0f, 45},
+    {"Extraction", 250.0f, 40}, {"RootCanal", 900.0f, 90}, {"Whitening", 600.0f, 60},
+    {"Crown", 1200.0f, 75}, {"XRay", 50.0f, 15}, {"BracesAdjustment", 180.0f, 30},
+    {"Implant", 3500.0f, 120}, {"Sealant", 90.0f, 20}, {"Checkup", 60.0f, 20},
+};
+const int CATALOG_SIZE = sizeof(CATALOG) / sizeof(CATALOG[0]);
+const int DAY_START = 8 * 60;
+const int DAY_END = 20 * 60;
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 5) {
+        std::cerr << "Usage: ./gen_history <output_dir> <appointments> [per_day=20] [seed=1]" << std::endl;
+        return 1;
+    }
+    const std::string dir = argv[1];
+    const long long total = std::stoll(argv[2]);
+    const int perDay = argc > 3 ? std::stoi(argv[3]) : 20;
+    const unsigned seed = argc > 4 ? static_cast<unsigned>(std::stoul(argv[4])) : 1u;
+    if (total < 0 || perDay <= 0) {
+        std::cerr << "Error: appointments must be >= 0 and per_day > 0." << std::endl;
+        return 1;
+    }
+
+    std::ofstream ops(dir + "/op_details.txt");
+    std::ofstream apps(dir + "/app_details.txt");
+    if (!ops || !apps) {
+        std::cerr << "Error: could not create files in " << dir << std::endl;
+        return 1;
+    }
+    for (const auto& op : CATALOG) {
+        ops << op.name << " " << op.price << " " << op.duration << '\n';
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pickOp(0, CATALOG_SIZE - 1);
+    std::uniform_int_distribution<int> gap(0, 15);
+    std::uniform_int_distribution<int> jitter(-perDay / 4, perDay / 4);
+    long dayNumber = daysFromCivil(1, 1, 2024);
+    long long written = 0;
+    while (written < total) {
+        int day, month, year;
+        civilFromDays(dayNumber++, day, month, year);
+        int target = perDay + jitter(rng);
+        int minute = DAY_START;
+        for (int i = 0; i < target && written < total; ++i) {
+            const GeneratedOperation& op = CATALOG[pickOp(rng)];
+            minute += gap(rng);
+            if (minute + op.duration > DAY_END) break;
+            apps << day << " " << month << " " << year << " " << minute / 60 << " " << minute % 60 << " " << op.name << '\n';
+            minute += op.duration;
+            ++written;
+        }
+    }
+    std::cerr << "Generated " << written << " appointments up to " << dayNumber - daysFromCivil(1, 1, 2024) << " days after 1/1/2024 in " << dir << std::endl;
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include "Scheduler.h"
+#include "Calendar.h"
+
+// Measures the hot Scheduler operations on a generated clinic (see gen_history) and prints
+// one JSON object per operation: throughput plus p50/p99 latency in microseconds.
+
+typedef std::chrono::steady_clock Clock;
+
+struct BenchResult {
+    std::string name;
+    std::vector<double> samplesMicros; // One sample per call
+};
+
+static double percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+static void report(const BenchResult& result, size_t appointments) {
+    double total = 0.0;
+    for (double sample : result.samplesMicros) total += sample;
+    std::printf("{\"op\":\"%s\",\"appointments\":%zu,\"calls\":%zu,\"ops_per_sec\":%.1f,\"p50_us\":%.3f,\"p99_us\":%.3f}\n",
+                result.name.c_str(), appointments, result.samplesMicros.size(),
+                total > 0.0 ? result.samplesMicros.size() * 1e6 / total : 0.0,
+                percentile(result.samplesMicros, 0.50), percentile(result.samplesMicros, 0.99));
+}
+
+template <typename Body>
+static double timeMicros(Body body) {
+    Clock::time_point start = Clock::now();
+    body();
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: ./scheduler_bench <clinic_dir> [queries=100000]" << std::endl;
+        return 1;
+    }
+    const std::string dir = argv[1];
+    const int queries = argc > 2 ? std::stoi(argv[2]) : 100000;
+    const std::string opsFile = dir + "/op_details.txt";
+    const std::string appsFile = dir + "/app_details.txt";
+    std::ostream discard(nullptr); // Output of the display methods is formatted but not written anywhere
+
+    BenchResult load = {"loadAppointments", {}};
+    Scheduler scheduler;
+    for (int run = 0; run < 3; ++run) {
+        Scheduler fresh;
+        if (!fresh.loadOperations(opsFile)) return 1;
+        fresh.loadResources(dir + "/res_details.txt");
+        load.samplesMicros.push_back(timeMicros([&]() { fresh.loadAppointments(appsFile); }));
+        if (run == 2) scheduler = std::move(fresh);
+    }
+    const size_t loaded = scheduler.appointments.size();
+    if (loaded == 0 || scheduler.operations.empty()) {
+        std::cerr << "Error: no appointments loaded from " << appsFile << std::endl;
+        return 1;
+    }
+    report(load, loaded);
+
+    // Queries target days inside the generated history
+    const Appointment& first = scheduler.appointments.front();
+    const Appointment& last = scheduler.appointments.back();
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<long> pickDay(first.dayNumber(), last.dayNumber());
+    std::uniform_int_distribution<int> pickMinute(8 * 60, 19 * 60);
+    std::uniform_int_distribution<int> pickOp(1, static_cast<int>(scheduler.operations.size()));
+
+    BenchResult slot = {"isSlotAvailable", {}};
+    for (int i = 0; i < queries; ++i) {
+        int day, month, year;
+        civilFromDays(pickDay(rng), day, month, year);
+        int minute = pickMinute(rng);
+        slot.samplesMicros.push_back(timeMicros([&]() { scheduler.isSlotAvailable(day, month, year, minute / 60, minute % 60, 30); }));
+    }
+    report(slot, loaded);
+
+    // scheduleAppointment only accepts years up to LAST_BOOKABLE_YEAR
+    const long firstDay = first.dayNumber();
+    std::uniform_int_distribution<long> pickBookableDay(firstDay, std::max(firstDay, std::min(pickDay.b(), daysFromCivil(31, 12, LAST_BOOKABLE_YEAR))));
+    BenchResult schedule = {"scheduleAppointment", {}};
+    for (int i = 0; i < queries; ++i) {
+        int day, month, year;
+        civilFromDays(pickBookableDay(rng), day, month, year);
+        int minute = pickMinute(rng);
+        int op = pickOp(rng);
+        schedule.samplesMicros.push_back(timeMicros([&]() {
+            scheduler.scheduleAppointment(day, month, year, minute / 60, minute % 60, op, nullptr, discard, discard);
+        }));
+    }
+    report(schedule, loaded);
+
+    // A month-long waiting list placed by the planner in one call
+    const long planStart = std::min(pickDay.b() + 1, daysFromCivil(1, 12, LAST_BOOKABLE_YEAR));
+    std::uniform_int_distribution<long> pickWindowStart(planStart, planStart + 27);
+    std::uniform_int_distribution<int> pickHour(8, 16);
+    std::vector<PlanRequest> waiting(std::max(1, queries / 50));
+    for (auto& request : waiting) {
+        request.operation = std::to_string(pickOp(rng));
+        request.earliestDay = pickWindowStart(rng);
+        request.latestDay = request.earliestDay + 3;
+        request.fromMinute = pickHour(rng) * 60;
+        request.toMinute = request.fromMinute + 4 * 60;
+    }
+    BenchResult plan = {"planRequests", {}};
+    plan.samplesMicros.push_back(timeMicros([&]() { scheduler.planRequests(waiting, PlanObjective::Requests); }));
+    report(plan, scheduler.appointments.size());
+
+    // Every day of the loaded history, from the day index built by the load
+    BenchResult availability = {"displayAvailabilityMap", {}};
+    for (int run = 0; run < 3; ++run) {
+        availability.samplesMicros.push_back(timeMicros([&]() {
+            scheduler.displayAvailabilityMap(firstDay, pickDay.b(), 30, discard);
+        }));
+    }
+    report(availability, scheduler.appointments.size());
+
+    const std::string savedFile = appsFile + ".bench";
+    BenchResult save = {"saveAppointments", {}};
+    for (int run = 0; run < 3; ++run) {
+        save.samplesMicros.push_back(timeMicros([&]() { scheduler.saveAppointments(savedFile); }));
+    }
+    std::remove(savedFile.c_str());
+    report(save, scheduler.appointments.size());
+
+    BenchResult history = {"displayAppointmentHistory", {}};
+    for (int run = 0; run < 3; ++run) {
+        std::ostringstream out;
+        history.samplesMicros.push_back(timeMicros([&]() { scheduler.displayAppointmentHistory(out); }));
+    }
+    report(history, scheduler.appointments.size());
+    return 0;
+}
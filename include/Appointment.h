@@ -1,19 +1,46 @@
 #ifndef APPOINTMENT_H
 #define APPOINTMENT_H
 
-#include "Operation.h" // Appointment conține un obiect Operation [cite: 3]
+#include <cstdint>        // Pentru int64_t, int32_t, int16_t
+#include "Operation.h"    // Appointment se referă la o operațiune din catalog prin indicele ei [cite: 3]
+#include "Calendar.h"     // Ziua, luna și anul se calculează doar la afișare
 
+// O programare în 16 octeți: începutul ca minut de la 1 ianuarie 1970, operațiunea, resursa și durata.
+// Sortarea și căutarea compară un singur întreg; data calendaristică se obține cu date(), hour() și minute().
 class Appointment {
 public:
-    int day, month, year, hour, minute; // Data și ora programării [cite: 3]
-    Operation operation;                // Operațiunea asociată [cite: 3]
+    int64_t start;        // Începutul, în minute de la 1 ianuarie 1970 (cheia de ordonare) [cite: 3]
+    int32_t operationId;  // Indicele operațiunii în Scheduler::operations [cite: 3]
+    int16_t resourceId;   // Indicele scaunului/medicului în Scheduler::resources
+    int16_t duration;     // Durata în minute, copiată din catalog la încărcare sau programare
 
     // Constructor implicit
-    Appointment() : day(0), month(0), year(0), hour(0), minute(0) {}
+    Appointment() : start(0), operationId(-1), resourceId(0), duration(0) {}
 
-    // Constructor parametrizat
-    Appointment(int d, int m, int y, int h, int min, const Operation& op)
-        : day(d), month(m), year(y), hour(h), minute(min), operation(op) {}
+    // Constructor parametrizat, din dată și oră calendaristică
+    Appointment(int d, int m, int y, int h, int min, int opId, int resId = 0, int dur = 0)
+        : start(static_cast<int64_t>(daysFromCivil(d, m, y)) * (24 * 60) + h * 60 + min), operationId(opId),
+          resourceId(static_cast<int16_t>(resId)), duration(static_cast<int16_t>(dur)) {}
+
+    // Ziua (daysFromCivil) și minutul din zi al începutului
+    long dayNumber() const {
+        return static_cast<long>(start >= 0 ? start / (24 * 60) : (start - (24 * 60 - 1)) / (24 * 60));
+    }
+    int minuteOfDay() const {
+        return static_cast<int>(start - static_cast<int64_t>(dayNumber()) * (24 * 60));
+    }
+    int hour() const { return minuteOfDay() / 60; }
+    int minute() const { return minuteOfDay() % 60; }
+    void date(int& day, int& month, int& year) const {
+        civilFromDays(dayNumber(), day, month, year);
+    }
+
+    // Comparator comun pentru sortare și căutare binară
+    static bool earlier(const Appointment& a, const Appointment& b) {
+        return a.start < b.start;
+    }
 };
 
-#endif // APPOINTMENT_H
\ No newline at end of file
+static_assert(sizeof(Appointment) == 16, "Appointment must stay packed in 16 bytes");
+
+#endif // APPOINTMENT_H
@@ -0,0 +1,29 @@
+#ifndef ARCHIVEMANIFEST_H
+#define ARCHIVEMANIFEST_H
+
+#include <string>
+#include <vector>
+#include <climits> // Pentru LONG_MIN
+
+// Istoricul arhivat se află în directorul <fișier programări>.archive/:
+//   manifest.txt  - prima linie "sealed_before <zi/lună/an>", apoi câte o linie pe segment:
+//                   <AAAA-LL> <prima zi z/l/a> <ultima zi z/l/a> <număr de programări>
+//   AAAA-LL.txt   - programările unei luni, sortate, în același format ca app_details.txt
+// Zilele de dinaintea lui sealed_before sunt sigilate: nu mai pot fi programate și nu sunt încărcate la pornire.
+
+// Un segment lunar al arhivei
+struct ArchiveSegment {
+    std::string name;    // AAAA-LL
+    long firstDay = 0;   // Prima zi cu programări (daysFromCivil)
+    long lastDay = 0;    // Ultima zi cu programări (daysFromCivil)
+    size_t records = 0;  // Numărul de programări din segment
+    bool loaded = false; // Programările segmentului sunt deja în memorie
+};
+
+// Conținutul manifestului
+struct ArchiveManifest {
+    long sealedBefore = LONG_MIN;          // Prima zi care nu este arhivată (daysFromCivil)
+    std::vector<ArchiveSegment> segments;  // În ordine cronologică
+};
+
+#endif // ARCHIVEMANIFEST_H
@@ -0,0 +1,60 @@
+#ifndef BINARYSNAPSHOT_H
+#define BINARYSNAPSHOT_H
+
+#include <cstdint> // Pentru tipurile cu lățime fixă
+#include <cstddef> // Pentru size_t
+
+// Formatul binar al instantaneului app_details.txt.bin:
+//   SnapshotHeader | SnapshotOperation[operationCount] | SnapshotResource[resourceCount] | SnapshotAppointment[appointmentCount]
+// Programările sunt scrise deja sortate cronologic.
+
+const char SNAPSHOT_MAGIC[8] = {'D', 'E', 'N', 'T', 'S', 'N', 'A', 'P'};
+const uint32_t SNAPSHOT_VERSION = 4; // 2: tabela de resurse și resourceIndex; 3: începutul ca minut de la 1970;
+                                     // 4: sourceModified în nanosecunde
+
+struct SnapshotHeader {
+    char magic[8];             // SNAPSHOT_MAGIC
+    uint32_t version;          // SNAPSHOT_VERSION
+    uint32_t operationCount;   // Numărul de intrări din tabela de operațiuni
+    uint32_t resourceCount;    // Numărul de intrări din tabela de resurse
+    uint32_t reserved;         // Zero; păstrează alinierea câmpurilor pe 64 de biți
+    uint64_t appointmentCount; // Numărul de programări
+    uint64_t sourceSize;       // Dimensiunea fișierului text din care a fost construit
+    int64_t sourceModified;    // Momentul ultimei modificări a fișierului text, în nanosecunde de la 1970
+    uint64_t checksum;         // FNV-1a peste tot ce urmează după antet
+};
+
+struct SnapshotOperation {
+    char name[50];    // Numele operațiunii, terminat cu '\0'
+    char padding[2];
+    float price;
+    int32_t duration;
+};
+
+struct SnapshotResource {
+    char name[50];    // Numele scaunului/medicului, terminat cu '\0'
+    char padding[2];
+};
+
+struct SnapshotAppointment {
+    int32_t start;           // Appointment::start; încape pe 32 de biți până în anul 6053
+    uint16_t operationIndex; // Indice în tabela de operațiuni a instantaneului
+    uint16_t resourceIndex;  // Indice în tabela de resurse a instantaneului
+};
+
+static_assert(sizeof(SnapshotHeader) == 56, "SnapshotHeader must have a fixed layout");
+static_assert(sizeof(SnapshotOperation) == 60, "SnapshotOperation must have a fixed layout");
+static_assert(sizeof(SnapshotResource) == 52, "SnapshotResource must have a fixed layout");
+static_assert(sizeof(SnapshotAppointment) == 8, "SnapshotAppointment must have a fixed layout");
+
+// Suma de control FNV-1a pe 64 de biți
+inline uint64_t snapshotChecksum(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+#endif // BINARYSNAPSHOT_H
@@ -0,0 +1,35 @@
+#ifndef BOOKINGREQUEST_H
+#define BOOKINGREQUEST_H
+
+// Rezultatul verificării unei cereri de programare
+enum class BookingStatus {
+    Accepted,
+    InvalidOperation, // Număr de operațiune inexistent
+    InvalidDateTime,  // Dată sau oră în afara intervalelor permise
+    PastMidnight,     // Operațiunea s-ar termina după miezul nopții
+    SlotTaken,        // Intervalul se suprapune cu o altă programare pe toate resursele compatibile
+    NoResource,       // Niciun scaun/medic nu poate efectua operațiunea
+    Archived          // Ziua face parte din istoricul arhivat (sigilat)
+};
+
+// O cerere de programare, cu aceleași câmpuri ca în comanda schedule
+struct BookingRequest {
+    int day, month, year, hour, minute;
+    int operation_number; // Numărul operațiunii din op_details.txt, începând de la 1
+};
+
+// Descriere scurtă a unui rezultat, pentru rapoarte
+inline const char* describeBookingStatus(BookingStatus status) {
+    switch (status) {
+        case BookingStatus::Accepted: return "accepted";
+        case BookingStatus::InvalidOperation: return "invalid operation number";
+        case BookingStatus::InvalidDateTime: return "invalid date or time";
+        case BookingStatus::PastMidnight: return "extends past midnight";
+        case BookingStatus::SlotTaken: return "time slot is not available";
+        case BookingStatus::NoResource: return "no chair or dentist can perform this operation";
+        case BookingStatus::Archived: return "date is in the archived history";
+    }
+    return "unknown";
+}
+
+#endif // BOOKINGREQUEST_H
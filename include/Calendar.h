@@ -0,0 +1,57 @@
+#ifndef CALENDAR_H
+#define CALENDAR_H
+
+#include <string>
+#include <cstdio> // Pentru sscanf
+
+// Funcții de calendar (gregorian proleptic) folosite pentru parcurgerea intervalelor de zile
+
+// Anii în care clinica acceptă programări; verificarea cererilor, planificatorul și benchmark-ul folosesc aceeași pereche
+const int FIRST_BOOKABLE_YEAR = 2024;
+const int LAST_BOOKABLE_YEAR = 2050;
+
+inline bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+inline int daysInMonth(int month, int year) {
+    static const int DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month < 1 || month > 12) return 0;
+    return month == 2 && isLeapYear(year) ? 29 : DAYS[month - 1];
+}
+
+inline bool isValidDate(int day, int month, int year) {
+    return month >= 1 && month <= 12 && day >= 1 && day <= daysInMonth(month, year);
+}
+
+// Numărul de zile de la 1 ianuarie 1970 (algoritmul "days from civil")
+inline long daysFromCivil(int day, int month, int year) {
+    long y = month <= 2 ? year - 1 : year;
+    long era = (y >= 0 ? y : y - 399) / 400;
+    long yoe = y - era * 400;
+    long doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Inversul lui daysFromCivil
+inline void civilFromDays(long days, int& day, int& month, int& year) {
+    days += 719468;
+    long era = (days >= 0 ? days : days - 146096) / 146097;
+    long doe = days - era * 146097;
+    long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long mp = (5 * doy + 2) / 153;
+    day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    year = static_cast<int>(yoe + era * 400 + (month <= 2 ? 1 : 0));
+}
+
+// Citește o dată de forma zi/lună/an; false dacă textul nu este o dată validă
+inline bool parseDate(const std::string& text, int& day, int& month, int& year) {
+    char trailing;
+    if (std::sscanf(text.c_str(), "%d/%d/%d%c", &day, &month, &year, &trailing) != 3) return false;
+    return isValidDate(day, month, year);
+}
+
+#endif // CALENDAR_H
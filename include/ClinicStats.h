@@ -0,0 +1,43 @@
+#ifndef CLINICSTATS_H
+#define CLINICSTATS_H
+
+#include <vector>
+#include <map>
+#include <cstddef> // Pentru size_t
+
+// Totaluri pe zile, actualizate la fiecare programare, pentru statisticile din admin_app.
+// Pentru fiecare zi se păstrează numărul de programări pe operațiune și minutele ocupate pe resursă,
+// într-un arbore Fenwick, astfel încât suma pe orice interval de zile costă O(log n).
+// Arborele acoperă doar anii în care se pot face programări; o înregistrare rătăcită în afara lor
+// (ex. anul 1 sau 9999) merge într-o tabelă separată pe zile, în loc să întindă arborele peste milenii.
+class ClinicStats {
+public:
+    ClinicStats();
+
+    // Golește totalurile; coloanele urmează catalogul de operațiuni și lista de resurse
+    void reset(size_t operationCount, size_t resourceCount);
+    // Adaugă (sign = 1) sau scade (sign = -1) o programare din ziua dayNumber (daysFromCivil)
+    void add(long dayNumber, int operationId, int resourceId, int minutes, int sign = 1);
+    // Numărul de programări pe operațiune și minutele ocupate pe resursă în zilele [fromDay, toDay]
+    void rangeTotals(long fromDay, long toDay, std::vector<long long>& operationCounts, std::vector<long long>& resourceMinutes) const;
+
+    bool empty() const { return days == 0 && outside.empty(); }
+    // Prima zi începând cu dayNumber care poate avea programări (LONG_MAX dacă nu mai există)
+    long nextCoveredDay(long dayNumber) const;
+
+private:
+    size_t operationCount; // Coloanele 0 .. operationCount - 1: programări pe operațiune
+    size_t columns;        // Restul coloanelor: minute ocupate pe resursă
+    long baseDay;          // Ziua corespunzătoare rândului 0
+    size_t days;           // Numărul de zile acoperite
+    std::vector<long long> values; // Totalurile fiecărei zile, rând după rând
+    std::vector<long long> tree;   // Arborele Fenwick peste values, cu rânduri numerotate de la 1
+    std::map<long, std::vector<long long>> outside; // Totalurile zilelor din afara anilor de programare
+
+    long lastDay() const { return baseDay + static_cast<long>(days) - 1; } // Ultima zi acoperită de arbore
+    void cover(long dayNumber);
+    void rebuildTree();
+    void prefix(size_t count, long long sign, std::vector<long long>& totals) const;
+};
+
+#endif // CLINICSTATS_H
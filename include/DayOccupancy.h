@@ -0,0 +1,153 @@
+#ifndef DAYOCCUPANCY_H
+#define DAYOCCUPANCY_H
+
+#include <cstdint> // Pentru uint64_t
+#include <cstring> // Pentru memset
+
+// Harta de ocupare a unei zile: un bit pentru fiecare minut (1 = ocupat)
+class DayOccupancy {
+public:
+    static const int MINUTES_PER_DAY = 24 * 60;
+    static const int WORDS = (MINUTES_PER_DAY + 63) / 64;
+
+    uint64_t bits[WORDS]; // 1440 de biți grupați în cuvinte de 64
+
+    // Constructor implicit - zi complet liberă
+    DayOccupancy() {
+        memset(bits, 0, sizeof(bits));
+    }
+
+    // Marchează intervalul [start, start + length) ca ocupat
+    void mark(int start, int length) {
+        int end = start + length;
+        if (start < 0) start = 0;
+        if (end > MINUTES_PER_DAY) end = MINUTES_PER_DAY;
+        for (int w = start / 64; start < end && w <= (end - 1) / 64; ++w) {
+            bits[w] |= rangeMask(w, start, end);
+        }
+    }
+
+    // Eliberează intervalul [start, start + length)
+    void unmark(int start, int length) {
+        int end = start + length;
+        if (start < 0) start = 0;
+        if (end > MINUTES_PER_DAY) end = MINUTES_PER_DAY;
+        for (int w = start / 64; start < end && w <= (end - 1) / 64; ++w) {
+            bits[w] &= ~rangeMask(w, start, end);
+        }
+    }
+
+    // Verifică dacă niciun minut din [start, start + length) nu este ocupat
+    bool isFree(int start, int length) const {
+        int end = start + length;
+        if (start < 0) start = 0;
+        if (end > MINUTES_PER_DAY) end = MINUTES_PER_DAY;
+        for (int w = start / 64; start < end && w <= (end - 1) / 64; ++w) {
+            if (bits[w] & rangeMask(w, start, end)) return false;
+        }
+        return true;
+    }
+
+    // Primul început >= from al unui interval liber de length minute, sau -1 dacă nu există
+    int findFreeRun(int from, int length) const {
+        if (from < 0) from = 0;
+        while (from + length <= MINUTES_PER_DAY) {
+            int freeStart = nextMinute(from, false);
+            if (freeStart < 0 || freeStart + length > MINUTES_PER_DAY) return -1;
+            int busyStart = nextMinute(freeStart, true);
+            if (busyStart < 0) busyStart = MINUTES_PER_DAY;
+            if (busyStart - freeStart >= length) return freeStart;
+            from = busyStart;
+        }
+        return -1;
+    }
+
+    // Ultimul început <= to al unui interval liber de length minute, sau -1 dacă nu există
+    int findFreeRunBefore(int to, int length) const {
+        int best = -1;
+        int from = 0;
+        while (from <= to && from + length <= MINUTES_PER_DAY) {
+            int freeStart = nextMinute(from, false);
+            if (freeStart < 0 || freeStart > to) break;
+            int busyStart = nextMinute(freeStart, true);
+            if (busyStart < 0) busyStart = MINUTES_PER_DAY;
+            if (busyStart - freeStart >= length) best = busyStart - length < to ? busyStart - length : to;
+            from = busyStart;
+        }
+        return best;
+    }
+
+    // Numărul de minute libere din zi (popcount pe cuvinte)
+    int freeMinutes() const {
+        int busy = 0;
+        for (int w = 0; w < WORDS; ++w) busy += countOnes(bits[w]);
+        return MINUTES_PER_DAY - busy;
+    }
+
+    // Cel mai lung interval liber din zi; fitting primește câte intervale disjuncte de length minute încap
+    int longestFreeRun(int length, int& fitting) const {
+        int longest = 0;
+        fitting = 0;
+        int from = 0;
+        while (from < MINUTES_PER_DAY) {
+            int freeStart = nextMinute(from, false);
+            if (freeStart < 0) break;
+            int busyStart = nextMinute(freeStart, true);
+            if (busyStart < 0) busyStart = MINUTES_PER_DAY;
+            if (busyStart - freeStart > longest) longest = busyStart - freeStart;
+            if (length > 0) fitting += (busyStart - freeStart) / length;
+            from = busyStart;
+        }
+        return longest;
+    }
+
+    // Verifică un singur minut
+    bool isMinuteFree(int minute) const {
+        if (minute < 0 || minute >= MINUTES_PER_DAY) return true;
+        return (bits[minute / 64] & (uint64_t(1) << (minute % 64))) == 0;
+    }
+
+private:
+    // Primul minut >= from care este ocupat (busy = true) sau liber (busy = false); -1 dacă nu există
+    int nextMinute(int from, bool busy) const {
+        for (int w = from / 64; w < WORDS; ++w) {
+            uint64_t word = busy ? bits[w] : ~bits[w];
+            if (w == from / 64) word &= ~uint64_t(0) << (from % 64);
+            if (word) {
+                int minute = w * 64 + countTrailingZeros(word);
+                return minute < MINUTES_PER_DAY ? minute : -1;
+            }
+        }
+        return -1;
+    }
+
+    static int countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int n = 0;
+        while (!(word & 1)) { word >>= 1; ++n; }
+        return n;
+#endif
+    }
+
+    static int countOnes(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#else
+        int n = 0;
+        for (; word; word &= word - 1) ++n;
+        return n;
+#endif
+    }
+
+    // Masca biților din cuvântul w care cad în intervalul [start, end)
+    static uint64_t rangeMask(int w, int start, int end) {
+        int lo = start > w * 64 ? start - w * 64 : 0;
+        int hi = end < (w + 1) * 64 ? end - w * 64 : 64;
+        uint64_t upper = hi == 64 ? ~uint64_t(0) : ((uint64_t(1) << hi) - 1);
+        return upper & ~((uint64_t(1) << lo) - 1);
+    }
+};
+
+#endif // DAYOCCUPANCY_H
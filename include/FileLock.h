@@ -0,0 +1,39 @@
+#ifndef FILELOCK_H
+#define FILELOCK_H
+
+#include <cstdint> // Pentru uint64_t
+#include <string>
+
+// Blocare exclusivă consultativă (advisory) a unui fișier, între procese (flock pe POSIX).
+// Fișierul este creat dacă lipsește; blocarea se eliberează la distrugere sau cu release().
+// Pe platformele fără flock blocarea nu are efect, ca înainte de existența ei.
+class FileLock {
+public:
+    explicit FileLock(const std::string& filename); // Așteaptă până obține blocarea
+    ~FileLock();
+
+    bool locked() const { return held; }
+    int descriptor() const { return fd; } // Descriptorul fișierului blocat, pentru citirea și scrierea conținutului lui
+    void release();
+
+private:
+    int fd;
+    bool held;
+
+    FileLock(const FileLock&);            // Necopiabil
+    FileLock& operator=(const FileLock&); // Necopiabil
+};
+
+// Un număr de 64 de biți păstrat la începutul unui fișier mic (0 dacă fișierul lipsește sau este gol)
+uint64_t readCounterFile(const std::string& filename);
+bool writeCounterFile(const std::string& filename, uint64_t value);
+
+// Scrie pe disc conținutul unui fișier (fsync); un fișier care nu există nu este o eroare
+bool syncFile(const std::string& filename);
+
+// Commit de grup: face jurnalul durabil până la octetul upTo. Fișierul <jurnal>.sync ține cât este deja
+// durabil, așa că un singur fsync acoperă toate adăugările concurente făcute înaintea lui.
+bool groupCommit(const std::string& filename, uint64_t upTo);
+bool resetGroupCommit(const std::string& filename); // După ce jurnalul a fost integrat și șters
+
+#endif // FILELOCK_H
@@ -0,0 +1,29 @@
+#ifndef HISTORYQUERY_H
+#define HISTORYQUERY_H
+
+#include <string>
+#include <vector>
+#include <climits> // Pentru LONG_MIN, LONG_MAX
+#include <cstdint> // Pentru SIZE_MAX
+
+// Formatul de afișare al istoricului
+enum class HistoryFormat {
+    Table, // Tabel colorat pentru terminal
+    Csv,   // date,time,operation,price,duration,resource
+    Json   // Tablou de obiecte JSON
+};
+
+// Filtrele și paginarea comenzii view_history
+struct HistoryQuery {
+    long fromDay = LONG_MIN;  // Prima zi inclusă (daysFromCivil)
+    long toDay = LONG_MAX;    // Ultima zi inclusă (daysFromCivil)
+    std::string operation;    // Nume sau număr de operațiune; gol = toate
+    size_t offset = 0;        // Programări potrivite sărite înainte de afișare
+    size_t limit = SIZE_MAX;  // Număr maxim de programări afișate
+    HistoryFormat format = HistoryFormat::Table;
+};
+
+// Citește opțiunile --from, --to, --op, --limit, --offset și --format; false și un mesaj de eroare dacă sunt invalide
+bool parseHistoryQuery(const std::vector<std::string>& args, HistoryQuery& query, std::string& error);
+
+#endif // HISTORYQUERY_H
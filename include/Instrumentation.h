@@ -0,0 +1,118 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>  // Pentru std::atomic
+#include <chrono>  // Pentru std::chrono::steady_clock
+#include <cstdint> // Pentru uint64_t
+#include <iosfwd>
+#include <string>
+
+// Instrumentare a căilor fierbinți din Scheduler: cronometre pe faze și contoare.
+// Dezactivată implicit; atunci fiecare punct de măsurare costă doar citirea unui bool.
+
+// Fazele cronometrate
+enum class Phase {
+    LoadOperations,  // Citirea catalogului de operațiuni
+    LoadResources,   // Citirea listei de scaune/medici
+    LoadSnapshot,    // Încărcarea instantaneului binar
+    ParseRecords,    // Parsarea fișierelor text (instantaneu și jurnal)
+    ReplayJournal,   // Integrarea jurnalului peste instantaneu
+    BuildIndex,      // Reconstruirea hărților de ocupare și a statisticilor
+    SlotCheck,       // Verificarea unei cereri de programare
+    Schedule,        // Programarea efectivă (inclusiv inserarea în listă)
+    FindSlots,       // Căutarea intervalelor libere
+    Availability,    // Harta disponibilității pe zile
+    Plan,            // Planificarea listei de așteptare
+    AppendJournal,   // Scrierea în jurnal
+    SyncJournal,     // Commit de grup: fsync pe jurnal, partajat între scriitorii concurenți
+    CatchUp,         // Aducerea în memorie a înregistrărilor scrise de alte procese
+    SaveRecords,     // Rescrierea fișierului text
+    SaveSnapshot,    // Scrierea instantaneului binar
+    Output,          // Formatarea și afișarea rezultatelor
+    Total,           // Întreaga invocare
+    Count
+};
+
+// Contoarele
+enum class Counter {
+    RecordsParsed,    // Programări citite din fișiere text
+    RecordsSkipped,   // Linii respinse la parsare
+    SnapshotRecords,  // Programări citite din instantaneul binar
+    SlotChecks,       // Cereri verificate
+    ResourceProbes,   // Hărți de ocupare consultate în verificări
+    RecordsWritten,   // Programări scrise în fișiere
+    BytesRead,        // Octeți citiți din fișierele de programări
+    BytesWritten,     // Octeți scriși în fișierele de programări
+    RowsDisplayed,    // Rânduri afișate de view_history
+    RecordsCaughtUp,  // Înregistrări din jurnal scrise de alte procese după încărcare
+    JournalSyncs,     // fsync-uri făcute pe jurnal
+    SyncsShared,      // Adăugări făcute durabile de fsync-ul altui scriitor
+    Count
+};
+
+class Instrumentation {
+public:
+    static void enable() { active.store(true, std::memory_order_relaxed); }
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    static void add(Counter counter, uint64_t amount = 1) {
+        if (enabled()) counters[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+    static uint64_t value(Counter counter) { return counters[static_cast<int>(counter)].load(std::memory_order_relaxed); }
+    static void record(Phase phase, uint64_t nanos) {
+        phaseNanos[static_cast<int>(phase)].fetch_add(nanos, std::memory_order_relaxed);
+        phaseCalls[static_cast<int>(phase)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void report(std::ostream& out);                // Tabel pentru stderr
+    static bool writeJson(const std::string& filename);   // Același raport ca obiect JSON
+
+private:
+    static inline std::atomic<bool> active{false};
+    static inline std::atomic<uint64_t> phaseNanos[static_cast<int>(Phase::Count)] = {};
+    static inline std::atomic<uint64_t> phaseCalls[static_cast<int>(Phase::Count)] = {};
+    static inline std::atomic<uint64_t> counters[static_cast<int>(Counter::Count)] = {};
+};
+
+// Cronometrează domeniul curent și adaugă durata la o fază
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Phase p) : phase(p), running(Instrumentation::enabled()) {
+        if (running) start = std::chrono::steady_clock::now();
+    }
+    ~ScopedTimer() {
+        if (running) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            Instrumentation::record(phase, static_cast<uint64_t>(elapsed.count()));
+        }
+    }
+
+private:
+    Phase phase;
+    bool running;
+    std::chrono::steady_clock::time_point start;
+
+    ScopedTimer(const ScopedTimer&);            // Necopiabil
+    ScopedTimer& operator=(const ScopedTimer&); // Necopiabil
+};
+
+// Pentru main: activează instrumentarea și afișează raportul la ieșirea din domeniu.
+// Argumentul --stats afișează raportul pe stderr, iar --stats=<fișier.json> îl scrie și ca JSON.
+class InstrumentationReport {
+public:
+    InstrumentationReport() : requested(false), start(std::chrono::steady_clock::now()) {}
+    ~InstrumentationReport();
+
+    // Consumă argv[1] dacă este --stats sau --stats=<fișier>; întoarce true dacă l-a consumat
+    bool parseFlag(int& argc, char**& argv);
+
+private:
+    bool requested;
+    std::string jsonFilename;
+    std::chrono::steady_clock::time_point start;
+
+    InstrumentationReport(const InstrumentationReport&);            // Necopiabil
+    InstrumentationReport& operator=(const InstrumentationReport&); // Necopiabil
+};
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,33 @@
+#ifndef JOURNALTRANSACTION_H
+#define JOURNALTRANSACTION_H
+
+#include <string>
+#include "Scheduler.h"
+#include "FileLock.h"
+
+// O modificare a programărilor sub blocarea jurnalului (compare-and-append), pentru mai multe procese care
+// scriu aceleași fișiere. La început aduce în memorie ce au scris celelalte procese de la încărcare, așa că
+// cererea este verificată față de toate programările; la sfârșit eliberează blocarea și face adăugările
+// durabile printr-un commit de grup, un singur fsync pentru toți scriitorii care au terminat între timp.
+class JournalTransaction {
+public:
+    JournalTransaction(Scheduler& scheduler, const std::string& filename);
+    ~JournalTransaction(); // release(), apoi commit-ul de grup
+
+    // Eliberează blocarea; după ea Scheduler-ul nu mai este folosit, așa că serverul își poate elibera
+    // propriul mutex înainte de fsync-ul din destructor
+    void release();
+
+private:
+    Scheduler& scheduler;
+    std::string journalFilename;
+    FileLock lock;
+    size_t startOffset; // Sfârșitul jurnalului după aducerea la zi
+    size_t endOffset;   // Sfârșitul jurnalului la eliberare
+    bool released;
+
+    JournalTransaction(const JournalTransaction&);            // Necopiabil
+    JournalTransaction& operator=(const JournalTransaction&); // Necopiabil
+};
+
+#endif // JOURNALTRANSACTION_H
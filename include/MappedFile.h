@@ -0,0 +1,30 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef> // Pentru size_t
+#include <string>
+#include <vector>
+
+// Fișier mapat în memorie doar pentru citire (mmap pe POSIX, citire integrală în rest)
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const std::string& filename); // Mapează fișierul; false dacă nu există sau nu poate fi citit
+    void close();
+
+    const char* data() const { return begin; }
+    size_t size() const { return length; }
+
+private:
+    const char* begin;
+    size_t length;
+    bool mapped;               // true dacă memoria vine din mmap și trebuie eliberată cu munmap
+    std::vector<char> buffer;  // Folosit când mmap nu este disponibil
+
+    MappedFile(const MappedFile&);            // Necopiabil
+    MappedFile& operator=(const MappedFile&); // Necopiabil
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,28 @@
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <algorithm> // Pentru std::min
+#include <atomic>    // Pentru std::atomic
+#include <thread>    // Pentru std::thread
+#include <vector>
+
+// Rulează task(i) pentru i = 0..count-1 pe un grup de fire de execuție care își împart sarcinile
+template <typename Task>
+void parallelFor(size_t count, Task task) {
+    size_t workers = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; ++i) task(i);
+        return;
+    }
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> pool;
+    pool.reserve(workers);
+    for (size_t w = 0; w < workers; ++w) {
+        pool.emplace_back([&]() {
+            for (size_t i = next++; i < count; i = next++) task(i);
+        });
+    }
+    for (auto& worker : pool) worker.join();
+}
+
+#endif // PARALLELFOR_H
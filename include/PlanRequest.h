@@ -0,0 +1,27 @@
+#ifndef PLANREQUEST_H
+#define PLANREQUEST_H
+
+#include <string>
+
+// Ce maximizează planificatorul când nu încap toate cererile
+enum class PlanObjective {
+    Requests, // Numărul de cereri programate (operațiunile scurte au prioritate)
+    Minutes   // Minutele ocupate (operațiunile lungi au prioritate)
+};
+
+// O cerere din lista de așteptare: o operațiune care trebuie programată între două zile, în orele preferate
+struct PlanRequest {
+    std::string operation;      // Nume sau număr de operațiune
+    long earliestDay = 0;       // Prima zi acceptată (daysFromCivil)
+    long latestDay = 0;         // Ultima zi acceptată (daysFromCivil)
+    int fromMinute = 0;         // Cel mai devreme început, în minute de la miezul nopții
+    int toMinute = 24 * 60;     // Cel mai târziu sfârșit, în minute de la miezul nopții
+};
+
+// Citește o linie "<operațiune> <de la z/l/a> <până la z/l/a> [oră-oră]"; false și un mesaj de eroare dacă este invalidă
+bool parsePlanRequest(const std::string& line, PlanRequest& request, std::string& error);
+
+// Citește obiectivul (requests sau minutes)
+bool parsePlanObjective(const std::string& text, PlanObjective& objective);
+
+#endif // PLANREQUEST_H
@@ -0,0 +1,35 @@
+#ifndef RECURRENCE_H
+#define RECURRENCE_H
+
+#include <string>
+#include <vector>
+#include <climits> // Pentru LONG_MAX
+#include "BookingRequest.h"
+
+// Numărul maxim de apariții ale unei serii (zece ani de programări săptămânale)
+const size_t MAX_SERIES_OCCURRENCES = 520;
+
+// Unitatea pasului de repetare
+enum class RecurrenceUnit {
+    Days,
+    Weeks,
+    Months // Aceeași zi din lună; în lunile mai scurte, ultima zi a lunii
+};
+
+// Regula unei serii: la fiecare every unități, de count ori sau până la untilDay inclusiv
+struct RecurrenceRule {
+    int every = 1;
+    RecurrenceUnit unit = RecurrenceUnit::Weeks;
+    size_t count = 0;        // 0 = se folosește untilDay
+    long untilDay = LONG_MAX; // Ultima zi permisă (daysFromCivil)
+};
+
+// Citește pasul (ex. 1w, 14d, 1m) și sfârșitul (un număr de apariții sau o dată zi/lună/an)
+bool parseRecurrenceRule(const std::string& every, const std::string& end, RecurrenceRule& rule, std::string& error);
+
+// Aparițiile seriei care începe cu first, în ordine cronologică; false (cu mesajul în error) dacă data de
+// sfârșit ar da mai mult de MAX_SERIES_OCCURRENCES apariții, în loc ca seria să fie tăiată fără avertisment
+bool expandRecurrence(const BookingRequest& first, const RecurrenceRule& rule, std::vector<BookingRequest>& occurrences,
+                      std::string& error);
+
+#endif // RECURRENCE_H
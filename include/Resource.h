@@ -0,0 +1,29 @@
+#ifndef RESOURCE_H
+#define RESOURCE_H
+
+#include <cstring> // Pentru strncpy
+#include <vector>
+
+// Un scaun sau un medic care poate fi rezervat pentru anumite operațiuni
+class Resource {
+public:
+    char name[50];                  // Numele resursei (ex. Chair1, DrPopescu)
+    std::vector<bool> supported;    // supported[id] = resursa poate efectua operațiunea id; gol = toate
+
+    // Constructor implicit
+    Resource() {
+        name[0] = '\0';
+    }
+
+    // Constructor parametrizat
+    explicit Resource(const char* n) {
+        strncpy(name, n, 49); // Copiază numele
+        name[49] = '\0';      // Asigură terminarea cu null
+    }
+
+    bool supports(int operationId) const {
+        return supported.empty() || (operationId >= 0 && static_cast<size_t>(operationId) < supported.size() && supported[operationId]);
+    }
+};
+
+#endif // RESOURCE_H
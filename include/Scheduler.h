@@ -3,30 +3,127 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <iostream>
 #include "Operation.h"    // Scheduler folosește Operation [cite: 8]
 #include "Appointment.h"  // Scheduler folosește Appointment [cite: 9]
+#include "Resource.h"     // Scaunele/medicii care pot fi rezervați
+#include "DayOccupancy.h" // Indexul de ocupare pe zile
+#include "BookingRequest.h"
+#include "HistoryQuery.h"
+#include "StatsQuery.h"
+#include "Recurrence.h"
+#include "PlanRequest.h"
+#include "ClinicStats.h"  // Totalurile pe zile pentru comanda stats
+#include "ArchiveManifest.h"
 
 class Scheduler {
 public:
-    std::vector<Operation> operations;     // Lista operațiunilor disponibile [cite: 4, 8]
+    std::vector<Operation> operations;     // Catalogul operațiunilor; indicele este ID-ul folosit de Appointment [cite: 4, 8]
     std::vector<Appointment> appointments; // Lista programărilor efectuate [cite: 4, 9]
+    std::vector<Resource> resources;       // Scaunele/medicii clinicii; indicele este ID-ul folosit de Appointment
 
     Scheduler(); // Constructor
 
     // Metode pentru gestionarea datelor
     bool loadOperations(const std::string& filename);
+    bool loadResources(const std::string& filename); // După loadOperations; fără fișier există o singură resursă
     bool loadAppointments(const std::string& filename);
+    // Aduce în memorie înregistrările scrise în jurnal de alte procese după încărcare (sub blocarea jurnalului, vezi JournalTransaction)
+    bool refreshAppointments(const std::string& filename);
+    bool hasExternalChanges(const std::string& filename) const; // Verificare ieftină: alt proces a scris în jurnal sau a făcut un checkpoint
     bool saveAppointments(const std::string& filename) const;
+    bool appendAppointment(const std::string& filename, const Appointment& app); // Adaugă o programare în jurnal
+    bool appendAppointments(const std::string& filename, const std::vector<Appointment>& apps);
+    // Adaugă în jurnal anularea unei programări și, la o mutare, noua programare, într-o singură scriere
+    bool appendCancellation(const std::string& filename, const Appointment& cancelled, const Appointment* replacement = nullptr);
+    // Integrează jurnalul în fișierul principal; instantaneul binar este rescris dacă există sau dacă buildSnapshot
+    bool checkpointAppointments(const std::string& filename, bool buildSnapshot = false);
+    size_t journalSize() const;
+    int findOperationId(const std::string& opName) const;    // ID-ul operațiunii cu acest nume, sau -1
+    const Operation& operationOf(const Appointment& app) const; // Operațiunea din catalog a unei programări
+    int findResourceId(const std::string& resourceName) const;  // ID-ul resursei cu acest nume, sau -1
+    bool saveBinarySnapshot(const std::string& filename) const;               // Scrie instantaneul binar al fișierului text
+    // Istoricul arhivat: la pornire se încarcă doar fișierul activ, segmentele lunare doar când o comandă le atinge
+    bool loadArchivedRange(long fromDay, long toDay);        // Încarcă segmentele care se suprapun cu [fromDay, toDay]
+    bool isArchiveLoaded(long fromDay, long toDay) const;    // Toate segmentele din interval sunt deja în memorie
+    bool archiveAppointments(const std::string& filename, long beforeDay, size_t& archived); // Sigilează zilele anterioare lui beforeDay
+    long sealedBefore() const;                               // Prima zi nearhivată, sau LONG_MIN
 
     // Metode pentru funcționalitatea sistemului
-    void displayOperations() const;
+    void displayOperations(std::ostream& out = std::cout) const;
     bool isSlotAvailable(int day, int month, int year, int hour, int minute, int operationDuration) const;
     bool isExactMinuteAvailable(int day, int month, int year, int hour, int minute) const;
-    bool scheduleAppointment(int day, int month, int year, int hour, int minute, int operation_number);
-    void displayAppointmentHistory() const;
+    void reportMinuteAvailability(int day, int month, int year, int hour, int minute, std::ostream& out = std::cout) const;
+    bool scheduleAppointment(int day, int month, int year, int hour, int minute, int operation_number, Appointment* scheduled = nullptr,
+                             std::ostream& out = std::cout, std::ostream& err = std::cerr);
+    // Verifică o cerere; resourceId primește prima resursă compatibilă liberă
+    BookingStatus checkBooking(const BookingRequest& request, int* resourceId = nullptr) const;
+    // Anulează programarea care începe la data și ora date; resourceId alege resursa când mai multe încep atunci (-1 = oricare).
+    // Căutarea este O(log n), dar ștergerea din vectorul sortat mută programările de după ea: O(n) în total
+    bool cancelAppointment(int day, int month, int year, int hour, int minute, int resourceId = -1, Appointment* cancelled = nullptr,
+                           std::ostream& out = std::cout, std::ostream& err = std::cerr);
+    // Mută o programare la o nouă dată și oră, cu aceeași operațiune; dacă noul interval nu este liber nu se schimbă nimic.
+    // Se deplasează programările dintre vechea și noua poziție, deci costul crește cu distanța mutării
+    bool rescheduleAppointment(int day, int month, int year, int hour, int minute, int newDay, int newMonth, int newYear, int newHour, int newMinute,
+                               int resourceId = -1, Appointment* previous = nullptr, Appointment* moved = nullptr,
+                               std::ostream& out = std::cout, std::ostream& err = std::cerr);
+    // Programează mai multe cereri într-o singură trecere; întoarce rezultatul fiecărei cereri
+    std::vector<BookingStatus> scheduleBatch(const std::vector<BookingRequest>& requests, std::vector<Appointment>* scheduled = nullptr);
+    // Programează toate aparițiile unei serii sau niciuna; rezultatul fiecărei apariții
+    std::vector<BookingStatus> bookSeries(const std::vector<BookingRequest>& occurrences, std::vector<Appointment>* scheduled = nullptr);
+    // Ca bookSeries, cu mesaje; pentru aparițiile ocupate afișează cel mai apropiat interval liber
+    bool scheduleSeries(const BookingRequest& first, const RecurrenceRule& rule, std::vector<Appointment>* scheduled = nullptr,
+                        std::ostream& out = std::cout, std::ostream& err = std::cerr);
+    // Planifică o listă de așteptare, maximizând cererile sau minutele programate; (*planned)[i] este programarea cererii i
+    std::vector<BookingStatus> planRequests(const std::vector<PlanRequest>& queue, PlanObjective objective, std::vector<Appointment>* planned = nullptr);
+    // Cel mai apropiat interval liber de o cerere: aceeași zi, apoi până la maxDays zile înainte sau după
+    bool nearestFreeSlot(const BookingRequest& request, int maxDays, BookingRequest& alternative) const;
+    // Primele count intervale libere (fără suprapuneri) pentru o operațiune, între două zile numerotate cu daysFromCivil
+    std::vector<BookingRequest> findFreeSlots(int operation_number, long firstDay, long lastDay, size_t count) const;
+    void displayAppointmentHistory(std::ostream& out = std::cout) const;
+    bool displayAppointmentHistory(const HistoryQuery& query, std::ostream& out = std::cout) const; // Istoric filtrat și paginat
+    void displayStats(const StatsQuery& query, std::ostream& out = std::cout) const; // Venituri și grad de ocupare pe un interval
+    // Pentru fiecare zi din [fromDay, toDay]: minutele libere și cel mai lung interval liber, față de o durată minGap;
+    // zilele arhivate sunt doar marcate, fără să intre în totaluri
+    bool displayAvailabilityMap(long fromDay, long toDay, int minGap, std::ostream& out = std::cout) const;
 
 private:
-    const Operation* findOperationByName(const char* opName) const;
+    friend class JournalTransaction;
+
+    size_t journalRecords;      // Numărul de înregistrări din jurnal încă neintegrate
+    size_t journalOffset;       // Octeții din jurnal deja citiți sau scriși de acest proces
+    size_t journalLines;        // Liniile de până la journalOffset, ca avertismentele să numere de la începutul jurnalului
+    uint64_t journalGeneration; // Crește la fiecare checkpoint; altă valoare înseamnă că instantaneul a fost rescris
+    std::unordered_map<std::string, int> operationIds; // Nume operațiune -> ID în catalog
+    // Ocuparea fiecărei zile pentru fiecare resursă: dayIndex[resursă][numărul zilei (daysFromCivil)]
+    std::vector<std::unordered_map<long, DayOccupancy>> dayIndex;
+    ClinicStats stats; // Actualizat împreună cu dayIndex, fără a reparcurge appointments la interogare
+    ArchiveManifest archive;      // Segmentele arhivate și limita de sigilare
+    std::string archiveDirectory; // Directorul arhivei fișierului încărcat
+
+    static long dateKey(int day, int month, int year);
+    static std::string journalFileName(const std::string& filename);
+    static std::string lockFileName(const std::string& filename);
+    static std::string binarySnapshotFileName(const std::string& filename);
+    static std::string archiveDirectoryName(const std::string& filename);
+    bool loadArchiveManifest(const std::string& filename);
+    bool saveArchiveManifest() const;
+    std::vector<Appointment>::const_iterator firstActive() const; // Prima programare din fișierul activ
+    bool loadBinarySnapshot(const std::string& filename);
+    bool readAppointmentRecords(const std::string& filename, std::vector<Appointment>& out, std::vector<Appointment>* cancelled = nullptr,
+                                size_t* offset = nullptr, size_t* line = nullptr) const;
+    void replayJournal(const std::string& filename, bool indexed); // Integrează jurnalul de la journalOffset încolo
+    void writeRecord(std::ostream& out, const Appointment& app) const;
+    const DayOccupancy* occupancy(int resourceId, int day, int month, int year) const;
+    const DayOccupancy* occupancy(int resourceId, long dayNumber) const;
+    int findFreeResource(int day, int month, int year, int start, int duration, int operationId) const;
+    void indexAppointment(const Appointment& app);
+    void unindexAppointment(std::vector<Appointment>::const_iterator app); // Eliberează minutele și scade programarea din statistici
+    bool locateAppointment(int day, int month, int year, int hour, int minute, int resourceId,
+                           std::vector<Appointment>::iterator& found, std::ostream& err);
+    bool appendJournal(const std::string& filename, const std::string& records, size_t count);
+    void rebuildDayIndex();
 };
 
 #endif // SCHEDULER_H
\ No newline at end of file
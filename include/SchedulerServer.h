@@ -0,0 +1,46 @@
+#ifndef SCHEDULERSERVER_H
+#define SCHEDULERSERVER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include "Scheduler.h" // Serverul păstrează un Scheduler încărcat în memorie
+
+// Statistici de latență pentru o comandă servită
+struct CommandLatency {
+    unsigned long long count = 0;
+    double totalMicros = 0.0;
+    double maxMicros = 0.0;
+};
+
+// Server rezident: ține Scheduler-ul și indexurile în memorie și servește comenzi pe un socket Unix
+class SchedulerServer {
+public:
+    SchedulerServer(Scheduler& scheduler, const std::string& appsFilename, size_t checkpointRecords);
+
+    bool run(const std::string& socketPath); // Blochează până la SIGINT/SIGTERM; clienții sunt serviți de un grup fix de fire
+
+    // Execută o comandă; întoarce codul de ieșire pe care l-ar fi avut aplicația locală
+    int execute(const std::vector<std::string>& args, std::ostream& out);
+    void reportLatency(std::ostream& out);
+
+private:
+    Scheduler& scheduler;
+    std::string appsFilename;
+    size_t checkpointRecords;
+    std::shared_mutex schedulerMutex;            // Citiri în paralel, scrieri serializate
+    std::mutex latencyMutex;
+    std::map<std::string, CommandLatency> latency; // Latența pe comandă
+
+    void handleClient(int clientFd);
+    void recordLatency(const std::string& command, double micros);
+    void loadArchivedRange(long fromDay, long toDay); // Încarcă segmentele arhivate necesare unei citiri
+    void catchUp(); // Înainte de o citire: aduce în memorie programările scrise de alte procese în jurnal
+};
+
+// Trimite o comandă către server și afișează răspunsul; întoarce codul de ieșire al comenzii
+int forwardCommand(const std::string& socketPath, const std::vector<std::string>& args);
+
+#endif // SCHEDULERSERVER_H
@@ -0,0 +1,25 @@
+#ifndef STATSQUERY_H
+#define STATSQUERY_H
+
+#include <string>
+#include <vector>
+
+// Gruparea rezultatelor comenzii stats
+enum class StatsGrouping {
+    Total,     // Un singur total și gradul de ocupare pe resursă
+    Day,       // Câte un rând pentru fiecare zi cu programări
+    Month,     // Câte un rând pentru fiecare lună cu programări
+    Operation  // Câte un rând pentru fiecare operațiune programată
+};
+
+// Intervalul și gruparea comenzii stats
+struct StatsQuery {
+    long fromDay = 0;  // Prima zi inclusă (daysFromCivil)
+    long toDay = 0;    // Ultima zi inclusă (daysFromCivil)
+    StatsGrouping grouping = StatsGrouping::Total;
+};
+
+// Citește <from d/m/y> <to d/m/y> [by=day|month|operation]; false și un mesaj de eroare dacă sunt invalide
+bool parseStatsQuery(const std::vector<std::string>& args, StatsQuery& query, std::string& error);
+
+#endif // STATSQUERY_H
@@ -0,0 +1,32 @@
+#ifndef TEXTFIELDS_H
+#define TEXTFIELDS_H
+
+#include <string_view>  // Pentru std::string_view
+#include <charconv>     // Pentru std::from_chars
+#include <system_error> // Pentru std::errc
+
+// Citire rapidă, independentă de locale, a câmpurilor separate prin spații dintr-o linie
+
+// Următorul câmp din [pos, end); gol dacă linia nu mai are câmpuri
+inline std::string_view nextField(const char*& pos, const char* end) {
+    while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) ++pos;
+    const char* start = pos;
+    while (pos < end && *pos != ' ' && *pos != '\t' && *pos != '\r') ++pos;
+    return std::string_view(start, static_cast<size_t>(pos - start));
+}
+
+// Întreg zecimal care ocupă tot câmpul
+inline bool parseField(std::string_view field, int& value) {
+    if (field.empty()) return false;
+    auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+    return result.ec == std::errc() && result.ptr == field.data() + field.size();
+}
+
+// Număr real care ocupă tot câmpul
+inline bool parseField(std::string_view field, float& value) {
+    if (field.empty()) return false;
+    auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+    return result.ec == std::errc() && result.ptr == field.data() + field.size();
+}
+
+#endif // TEXTFIELDS_H
@@ -0,0 +1,144 @@
+#include "ClinicStats.h"
+#include "Calendar.h"
+#include <algorithm>    // For std::min, std::max, std::copy, std::all_of
+#include <climits>      // For LONG_MAX
+
+// Days the Fenwick tree may cover: the years bookings are accepted for
+static const long INDEXED_FIRST_DAY = daysFromCivil(1, 1, FIRST_BOOKABLE_YEAR);
+static const long INDEXED_LAST_DAY = daysFromCivil(31, 12, LAST_BOOKABLE_YEAR);
+
+// Constructor - no days covered yet
+ClinicStats::ClinicStats() : operationCount(0), columns(0), baseDay(0), days(0) {}
+
+/**
+ * @brief Drops all totals and sets the columns for a catalog and a resource list.
+ */
+void ClinicStats::reset(size_t operations, size_t resources) {
+    operationCount = operations;
+    columns = operations + resources;
+    baseDay = 0;
+    days = 0;
+    values.clear();
+    tree.clear();
+    outside.clear();
+}
+
+/**
+ * @brief Adds or removes one appointment in the totals of its day.
+ */
+void ClinicStats::add(long dayNumber, int operationId, int resourceId, int minutes, int sign) {
+    if (operationId < 0 || static_cast<size_t>(operationId) >= operationCount ||
+        resourceId < 0 || operationCount + resourceId >= columns) {
+        return;
+    }
+    const size_t cells[2] = {static_cast<size_t>(operationId), operationCount + resourceId};
+    const long long amounts[2] = {sign, static_cast<long long>(sign) * minutes};
+    if (dayNumber < INDEXED_FIRST_DAY || dayNumber > INDEXED_LAST_DAY) {
+        std::vector<long long>& totals = outside[dayNumber];
+        totals.resize(columns, 0);
+        totals[cells[0]] += amounts[0];
+        totals[cells[1]] += amounts[1];
+        if (std::all_of(totals.begin(), totals.end(), [](long long value) { return value == 0; })) {
+            outside.erase(dayNumber);
+        }
+        return;
+    }
+    cover(dayNumber);
+    size_t row = static_cast<size_t>(dayNumber - baseDay);
+    for (int k = 0; k < 2; ++k) {
+        values[row * columns + cells[k]] += amounts[k];
+        for (size_t i = row + 1; i <= days; i += i & (~i + 1)) {
+            tree[i * columns + cells[k]] += amounts[k];
+        }
+    }
+}
+
+/**
+ * @brief Sums every column over an inclusive range of days with two prefix queries.
+ */
+void ClinicStats::rangeTotals(long fromDay, long toDay, std::vector<long long>& operationCounts, std::vector<long long>& resourceMinutes) const {
+    std::vector<long long> totals(columns, 0);
+    if (days > 0) {
+        long first = std::max(fromDay, baseDay);
+        long last = std::min(toDay, lastDay());
+        if (first <= last) {
+            prefix(static_cast<size_t>(last - baseDay + 1), 1, totals);
+            prefix(static_cast<size_t>(first - baseDay), -1, totals);
+        }
+    }
+    for (auto it = outside.lower_bound(fromDay); it != outside.end() && it->first <= toDay; ++it) {
+        for (size_t c = 0; c < columns; ++c) {
+            totals[c] += it->second[c];
+        }
+    }
+    operationCounts.assign(totals.begin(), totals.begin() + operationCount);
+    resourceMinutes.assign(totals.begin() + operationCount, totals.end());
+}
+
+/**
+ * @brief Returns the first day from dayNumber on that is covered by the tree or holds a record outside it.
+ */
+long ClinicStats::nextCoveredDay(long dayNumber) const {
+    long next = LONG_MAX;
+    if (days > 0 && dayNumber <= lastDay()) {
+        next = std::max(dayNumber, baseDay);
+    }
+    auto stray = outside.lower_bound(dayNumber);
+    if (stray != outside.end()) {
+        next = std::min(next, stray->first);
+    }
+    return next;
+}
+
+/**
+ * @brief Extends the covered days so that dayNumber has a row, keeping the existing totals; the tree never
+ * grows past the bookable years.
+ */
+void ClinicStats::cover(long dayNumber) {
+    if (days > 0 && dayNumber >= baseDay && dayNumber <= lastDay()) {
+        return;
+    }
+    long first = days > 0 ? std::min(baseDay, dayNumber) : dayNumber;
+    long last = days > 0 ? std::max(lastDay(), dayNumber) : dayNumber;
+    // Grow by at least half the covered span, so loading a history day by day stays amortized O(1) per day
+    long slack = std::max(64L, (last - first + 1) / 2);
+    if (days == 0 || dayNumber < baseDay) first -= slack;
+    if (days == 0 || dayNumber > lastDay()) last += slack;
+    first = std::max(first, INDEXED_FIRST_DAY);
+    last = std::min(last, INDEXED_LAST_DAY);
+
+    std::vector<long long> grown(static_cast<size_t>(last - first + 1) * columns, 0);
+    if (days > 0) {
+        std::copy(values.begin(), values.end(), grown.begin() + static_cast<size_t>(baseDay - first) * columns);
+    }
+    values.swap(grown);
+    baseDay = first;
+    days = static_cast<size_t>(last - first + 1);
+    rebuildTree();
+}
+
+/**
+ * @brief Builds the Fenwick tree over the per-day totals in linear time.
+ */
+void ClinicStats::rebuildTree() {
+    tree.assign((days + 1) * columns, 0);
+    std::copy(values.begin(), values.end(), tree.begin() + columns);
+    for (size_t i = 1; i <= days; ++i) {
+        size_t parent = i + (i & (~i + 1));
+        if (parent > days) continue;
+        for (size_t c = 0; c < columns; ++c) {
+            tree[parent * columns + c] += tree[i * columns + c];
+        }
+    }
+}
+
+/**
+ * @brief Adds sign times the totals of the first count days to totals.
+ */
+void ClinicStats::prefix(size_t count, long long sign, std::vector<long long>& totals) const {
+    for (size_t i = count; i > 0; i -= i & (~i + 1)) {
+        for (size_t c = 0; c < columns; ++c) {
+            totals[c] += sign * tree[i * columns + c];
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#include "FileLock.h"
+#include "Instrumentation.h"
+#include <cerrno>       // For errno, EINTR, ENOENT
+
+#ifndef _WIN32
+#include <fcntl.h>      // For open
+#include <sys/file.h>   // For flock
+#include <sys/stat.h>   // For fstat
+#include <unistd.h>     // For pread, pwrite, fsync, ftruncate, close
+#endif
+
+/**
+ * @brief Opens (creating if needed) and exclusively locks a file, waiting for other holders.
+ */
+FileLock::FileLock(const std::string& filename) : fd(-1), held(false) {
+#ifndef _WIN32
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return;
+    }
+    int result;
+    do {
+        result = ::flock(fd, LOCK_EX);
+    } while (result != 0 && errno == EINTR);
+    held = result == 0;
+#else
+    (void)filename;
+#endif
+}
+
+FileLock::~FileLock() {
+    release();
+}
+
+/**
+ * @brief Releases the lock before the object goes out of scope.
+ */
+void FileLock::release() {
+#ifndef _WIN32
+    if (held) {
+        ::flock(fd, LOCK_UN);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#endif
+    fd = -1;
+    held = false;
+}
+
+/**
+ * @brief Reads the counter stored at the start of a file.
+ */
+uint64_t readCounterFile(const std::string& filename) {
+    uint64_t value = 0;
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    if (::pread(fd, &value, sizeof(value), 0) != static_cast<ssize_t>(sizeof(value))) {
+        value = 0;
+    }
+    ::close(fd);
+#else
+    (void)filename;
+#endif
+    return value;
+}
+
+/**
+ * @brief Stores a counter at the start of a file, creating the file if needed.
+ */
+bool writeCounterFile(const std::string& filename, uint64_t value) {
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool written = ::pwrite(fd, &value, sizeof(value), 0) == static_cast<ssize_t>(sizeof(value));
+    ::close(fd);
+    return written;
+#else
+    (void)filename;
+    (void)value;
+    return true;
+#endif
+}
+
+/**
+ * @brief Flushes a file's contents to the disk.
+ */
+bool syncFile(const std::string& filename) {
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return errno == ENOENT;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#else
+    (void)filename;
+    return true;
+#endif
+}
+
+/**
+ * @brief Makes the journal durable up to a byte offset, unless a concurrent writer's fsync already did.
+ *
+ * Writers append under the journal lock and call this after releasing it. The first one to get the
+ * sync lock flushes everything appended so far and records the journal size; the writers that were
+ * queued behind it find their offset covered and return without a second fsync.
+ */
+bool groupCommit(const std::string& filename, uint64_t upTo) {
+    ScopedTimer timer(Phase::SyncJournal);
+#ifndef _WIN32
+    FileLock syncLock(filename + ".sync");
+    if (!syncLock.locked()) {
+        Instrumentation::add(Counter::JournalSyncs);
+        return syncFile(filename);
+    }
+    uint64_t durable = 0;
+    if (::pread(syncLock.descriptor(), &durable, sizeof(durable), 0) != static_cast<ssize_t>(sizeof(durable))) {
+        durable = 0;
+    }
+    if (durable >= upTo) {
+        Instrumentation::add(Counter::SyncsShared);
+        return true;
+    }
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return errno == ENOENT; // Folded into the snapshot by a checkpoint, which synced it
+    }
+    struct stat st;
+    bool synced = ::fstat(fd, &st) == 0 && ::fsync(fd) == 0; // The size is read first, so it never claims more than was flushed
+    ::close(fd);
+    Instrumentation::add(Counter::JournalSyncs);
+    if (synced) {
+        durable = static_cast<uint64_t>(st.st_size);
+        synced = ::pwrite(syncLock.descriptor(), &durable, sizeof(durable), 0) == static_cast<ssize_t>(sizeof(durable));
+    }
+    return synced;
+#else
+    (void)upTo;
+    return syncFile(filename);
+#endif
+}
+
+/**
+ * @brief Forgets the durable offset of a journal that was removed, so a new journal starts from zero.
+ */
+bool resetGroupCommit(const std::string& filename) {
+#ifndef _WIN32
+    FileLock syncLock(filename + ".sync");
+    return syncLock.locked() && ::ftruncate(syncLock.descriptor(), 0) == 0;
+#else
+    (void)filename;
+    return true;
+#endif
+}
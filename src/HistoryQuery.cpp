@@ -0,0 +1,59 @@
+#include "HistoryQuery.h"
+#include "Calendar.h"
+#include <stdexcept>    // For std::invalid_argument, std::out_of_range
+
+/**
+ * @brief Parses a non-negative count option.
+ */
+static bool parseCount(const std::string& text, size_t& value) {
+    try {
+        size_t used = 0;
+        long long parsed = std::stoll(text, &used);
+        if (used != text.size() || parsed < 0) return false;
+        value = static_cast<size_t>(parsed);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+/**
+ * @brief Parses the view_history options that follow the command name.
+ */
+bool parseHistoryQuery(const std::vector<std::string>& args, HistoryQuery& query, std::string& error) {
+    for (size_t i = 0; i < args.size(); i += 2) {
+        const std::string& option = args[i];
+        if (i + 1 >= args.size()) {
+            error = "Option " + option + " needs a value.";
+            return false;
+        }
+        const std::string& value = args[i + 1];
+        int day, month, year;
+        if (option == "--from" || option == "--to") {
+            if (!parseDate(value, day, month, year)) {
+                error = "Invalid date '" + value + "' (expected day/month/year).";
+                return false;
+            }
+            (option == "--from" ? query.fromDay : query.toDay) = daysFromCivil(day, month, year);
+        } else if (option == "--op") {
+            query.operation = value;
+        } else if (option == "--limit" || option == "--offset") {
+            if (!parseCount(value, option == "--limit" ? query.limit : query.offset)) {
+                error = "Invalid count '" + value + "' for " + option + ".";
+                return false;
+            }
+        } else if (option == "--format") {
+            if (value == "table") query.format = HistoryFormat::Table;
+            else if (value == "csv") query.format = HistoryFormat::Csv;
+            else if (value == "json") query.format = HistoryFormat::Json;
+            else {
+                error = "Unknown format '" + value + "' (expected table, csv or json).";
+                return false;
+            }
+        } else {
+            error = "Unknown option '" + option + "'.";
+            return false;
+        }
+    }
+    return true;
+}
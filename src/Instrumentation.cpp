@@ -0,0 +1,113 @@
+#include "Instrumentation.h"
+#include <fstream>      // For std::ofstream
+#include <iostream>     // For std::cerr, std::endl
+#include <iomanip>      // For std::setw, std::setprecision
+
+// ANSI Color codes
+const std::string RESET = "\033[0m";
+const std::string RED = "\033[31m";
+const std::string GREEN = "\033[32m";
+const std::string BLUE = "\033[34m";
+const std::string MAGENTA = "\033[35m";
+const std::string CYAN = "\033[36m";
+const std::string WHITE = "\033[37m";
+const std::string BOLD = "\033[1m";
+
+// Report names, in the order of the Phase and Counter enums
+static const char* const PHASE_NAMES[] = {
+    "load_operations", "load_resources", "load_snapshot", "parse_records", "replay_journal", "build_index",
+    "slot_check", "schedule", "find_slots", "availability", "plan", "append_journal", "sync_journal", "catch_up",
+    "save_records", "save_snapshot", "output", "total"
+};
+static const char* const COUNTER_NAMES[] = {
+    "records_parsed", "records_skipped", "snapshot_records", "slot_checks", "resource_probes",
+    "records_written", "bytes_read", "bytes_written", "rows_displayed", "records_caught_up", "journal_syncs", "syncs_shared"
+};
+static_assert(sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]) == static_cast<size_t>(Phase::Count), "Every phase needs a name");
+static_assert(sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == static_cast<size_t>(Counter::Count), "Every counter needs a name");
+
+/**
+ * @brief Prints the phases that ran and the non-zero counters as a table.
+ */
+void Instrumentation::report(std::ostream& out) {
+    const std::string rule = "-------------------------------------------------------";
+    out << CYAN << BOLD << "\nInstrumentation:" << RESET << std::endl;
+    out << BLUE << rule << RESET << std::endl;
+    out << std::left << MAGENTA << BOLD << std::setw(20) << "Phase" << std::setw(10) << "Calls"
+        << std::setw(13) << "Total (ms)" << "Mean (us)" << RESET << std::endl;
+    out << BLUE << rule << RESET << std::endl;
+    for (int i = 0; i < static_cast<int>(Phase::Count); ++i) {
+        uint64_t calls = phaseCalls[i].load(std::memory_order_relaxed);
+        if (calls == 0) continue;
+        double nanos = static_cast<double>(phaseNanos[i].load(std::memory_order_relaxed));
+        out << std::left << WHITE << std::setw(20) << PHASE_NAMES[i] << GREEN << std::setw(10) << calls
+            << CYAN << std::fixed << std::setprecision(3) << std::setw(13) << nanos / 1e6
+            << nanos / 1e3 / calls << RESET << std::endl;
+    }
+    out << BLUE << rule << RESET << std::endl;
+    for (int i = 0; i < static_cast<int>(Counter::Count); ++i) {
+        uint64_t value = counters[i].load(std::memory_order_relaxed);
+        if (value == 0) continue;
+        out << std::left << WHITE << std::setw(20) << COUNTER_NAMES[i] << GREEN << value << RESET << std::endl;
+    }
+    out << BLUE << rule << RESET << "\n" << std::endl;
+}
+
+/**
+ * @brief Writes every phase and counter to a JSON file, zeros included, so reports can be diffed.
+ */
+bool Instrumentation::writeJson(const std::string& filename) {
+    std::ofstream outFile(filename);
+    if (!outFile) {
+        return false;
+    }
+    outFile << "{\"phases\":{";
+    for (int i = 0; i < static_cast<int>(Phase::Count); ++i) {
+        outFile << (i ? "," : "") << "\n  \"" << PHASE_NAMES[i] << "\":{\"calls\":" << phaseCalls[i].load(std::memory_order_relaxed)
+                << ",\"total_ns\":" << phaseNanos[i].load(std::memory_order_relaxed) << "}";
+    }
+    outFile << "\n},\"counters\":{";
+    for (int i = 0; i < static_cast<int>(Counter::Count); ++i) {
+        outFile << (i ? "," : "") << "\n  \"" << COUNTER_NAMES[i] << "\":" << counters[i].load(std::memory_order_relaxed);
+    }
+    outFile << "\n}}\n";
+    outFile.close();
+    return !outFile.fail();
+}
+
+/**
+ * @brief Enables instrumentation if the first argument asks for a report, and removes that argument.
+ */
+bool InstrumentationReport::parseFlag(int& argc, char**& argv) {
+    if (argc < 2) {
+        return false;
+    }
+    std::string flag = argv[1];
+    if (flag != "--stats" && flag.compare(0, 8, "--stats=") != 0) {
+        return false;
+    }
+    requested = true;
+    if (flag.size() > 8) {
+        jsonFilename = flag.substr(8);
+    }
+    Instrumentation::enable();
+    argv[1] = argv[0]; // The command now starts at argv[1] again
+    ++argv;
+    --argc;
+    return true;
+}
+
+/**
+ * @brief Records the total run time and prints the report when --stats was given.
+ */
+InstrumentationReport::~InstrumentationReport() {
+    if (!requested) {
+        return;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    Instrumentation::record(Phase::Total, static_cast<uint64_t>(elapsed.count()));
+    Instrumentation::report(std::cerr);
+    if (!jsonFilename.empty() && !Instrumentation::writeJson(jsonFilename)) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not write the instrumentation report to " << jsonFilename << std::endl;
+    }
+}
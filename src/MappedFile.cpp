@@ -0,0 +1,71 @@
+#include "MappedFile.h"
+#include <fstream>      // For std::ifstream
+#include <iterator>     // For std::istreambuf_iterator
+
+#ifndef _WIN32
+#include <fcntl.h>      // For open
+#include <sys/mman.h>   // For mmap, munmap
+#include <sys/stat.h>   // For fstat
+#include <unistd.h>     // For close
+#endif
+
+MappedFile::MappedFile() : begin(nullptr), length(0), mapped(false) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+/**
+ * @brief Maps the whole file read-only, falling back to reading it into memory.
+ */
+bool MappedFile::open(const std::string& filename) {
+    close();
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    length = static_cast<size_t>(st.st_size);
+    if (length == 0) {
+        ::close(fd);
+        begin = "";
+        return true;
+    }
+    void* addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr != MAP_FAILED) {
+        begin = static_cast<const char*>(addr);
+        mapped = true;
+        return true;
+    }
+    length = 0;
+#endif
+    std::ifstream inFile(filename, std::ios::binary);
+    if (!inFile) {
+        return false;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+    begin = buffer.empty() ? "" : buffer.data();
+    length = buffer.size();
+    return true;
+}
+
+/**
+ * @brief Releases the mapping or the fallback buffer.
+ */
+void MappedFile::close() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char*>(begin), length);
+    }
+#endif
+    begin = nullptr;
+    length = 0;
+    mapped = false;
+    std::vector<char>().swap(buffer);
+}
@@ -0,0 +1,71 @@
+#include "PlanRequest.h"
+#include "Calendar.h"
+#include <sstream>      // For std::istringstream
+#include <cstdio>       // For std::sscanf
+
+/**
+ * @brief Parses a time of day written as H or H:MM; 24 (or 24:00) is accepted as the end of the day.
+ */
+static bool parseTimeOfDay(const std::string& text, int& minutes) {
+    int hour = 0, minute = 0;
+    char trailing;
+    int fields = std::sscanf(text.c_str(), "%d:%d%c", &hour, &minute, &trailing);
+    if (fields != 1 && fields != 2) return false;
+    if (fields == 1 && text.find(':') != std::string::npos) return false;
+    if (hour < 0 || hour > 24 || minute < 0 || minute > 59 || (hour == 24 && minute != 0)) return false;
+    minutes = hour * 60 + minute;
+    return true;
+}
+
+/**
+ * @brief Parses one waiting-list line: <operation> <earliest d/m/y> <latest d/m/y> [from-to].
+ */
+bool parsePlanRequest(const std::string& line, PlanRequest& request, std::string& error) {
+    std::istringstream fields(line);
+    std::string earliest, latest, hours, extra;
+    if (!(fields >> request.operation >> earliest >> latest)) {
+        error = "expected '<operation> <earliest d/m/y> <latest d/m/y> [hours]'";
+        return false;
+    }
+    int day, month, year;
+    if (!parseDate(earliest, day, month, year)) {
+        error = "invalid earliest date '" + earliest + "'";
+        return false;
+    }
+    request.earliestDay = daysFromCivil(day, month, year);
+    if (!parseDate(latest, day, month, year)) {
+        error = "invalid latest date '" + latest + "'";
+        return false;
+    }
+    request.latestDay = daysFromCivil(day, month, year);
+    if (request.latestDay < request.earliestDay) {
+        error = "the latest date is before the earliest date";
+        return false;
+    }
+
+    request.fromMinute = 0;
+    request.toMinute = 24 * 60;
+    if (fields >> hours) {
+        size_t dash = hours.find('-');
+        if (dash == std::string::npos || !parseTimeOfDay(hours.substr(0, dash), request.fromMinute) ||
+            !parseTimeOfDay(hours.substr(dash + 1), request.toMinute) || request.toMinute <= request.fromMinute) {
+            error = "invalid preferred hours '" + hours + "' (expected e.g. 8-12 or 14:30-18)";
+            return false;
+        }
+    }
+    if (fields >> extra) {
+        error = "unexpected field '" + extra + "'";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Parses the planner objective.
+ */
+bool parsePlanObjective(const std::string& text, PlanObjective& objective) {
+    if (text == "requests") objective = PlanObjective::Requests;
+    else if (text == "minutes") objective = PlanObjective::Minutes;
+    else return false;
+    return true;
+}
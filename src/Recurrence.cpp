@@ -0,0 +1,95 @@
+#include "Recurrence.h"
+#include "Calendar.h"
+#include <algorithm>    // For std::min
+#include <stdexcept>    // For std::invalid_argument, std::out_of_range
+
+/**
+ * @brief Returns the message shown for a series longer than MAX_SERIES_OCCURRENCES.
+ */
+static std::string occurrenceLimitError(const std::string& end) {
+    return "Invalid occurrence count '" + end + "' (expected 1 to " + std::to_string(MAX_SERIES_OCCURRENCES) + " or an end date).";
+}
+
+/**
+ * @brief Parses the step and the end of a recurrence rule.
+ */
+bool parseRecurrenceRule(const std::string& every, const std::string& end, RecurrenceRule& rule, std::string& error) {
+    size_t used = 0;
+    int step = 0;
+    try {
+        step = std::stoi(every, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used + 1 != every.size() || step <= 0) {
+        error = "Invalid repeat step '" + every + "' (expected a number followed by d, w or m, e.g. 1w).";
+        return false;
+    }
+    switch (every[used]) {
+        case 'd': rule.unit = RecurrenceUnit::Days; break;
+        case 'w': rule.unit = RecurrenceUnit::Weeks; break;
+        case 'm': rule.unit = RecurrenceUnit::Months; break;
+        default:
+            error = "Invalid repeat unit in '" + every + "' (expected d, w or m).";
+            return false;
+    }
+    rule.every = step;
+
+    int day, month, year;
+    if (end.find('/') != std::string::npos) {
+        if (!parseDate(end, day, month, year)) {
+            error = "Invalid end date '" + end + "' (expected day/month/year).";
+            return false;
+        }
+        rule.count = 0;
+        rule.untilDay = daysFromCivil(day, month, year);
+        return true;
+    }
+    long long count = 0;
+    try {
+        count = std::stoll(end, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != end.size() || count <= 0 || static_cast<unsigned long long>(count) > MAX_SERIES_OCCURRENCES) {
+        error = occurrenceLimitError(end);
+        return false;
+    }
+    rule.count = static_cast<size_t>(count);
+    return true;
+}
+
+/**
+ * @brief Lists the occurrences of a series; an end date reaching past MAX_SERIES_OCCURRENCES is rejected like a count would be.
+ */
+bool expandRecurrence(const BookingRequest& first, const RecurrenceRule& rule, std::vector<BookingRequest>& occurrences,
+                      std::string& error) {
+    occurrences.clear();
+    // One occurrence past the cap is generated so that an end date that allows it can be told apart from one that does not
+    size_t limit = rule.count > 0 ? std::min(rule.count, MAX_SERIES_OCCURRENCES) : MAX_SERIES_OCCURRENCES + 1;
+    long firstDay = daysFromCivil(first.day, first.month, first.year);
+    for (size_t i = 0; i < limit; ++i) {
+        BookingRequest occurrence = first;
+        if (rule.unit == RecurrenceUnit::Months) {
+            long months = (first.month - 1) + static_cast<long>(i) * rule.every;
+            occurrence.year = first.year + static_cast<int>(months / 12);
+            occurrence.month = static_cast<int>(months % 12) + 1;
+            occurrence.day = std::min(first.day, daysInMonth(occurrence.month, occurrence.year));
+        } else {
+            long step = rule.unit == RecurrenceUnit::Weeks ? 7L * rule.every : rule.every;
+            civilFromDays(firstDay + static_cast<long>(i) * step, occurrence.day, occurrence.month, occurrence.year);
+        }
+        if (daysFromCivil(occurrence.day, occurrence.month, occurrence.year) > rule.untilDay) {
+            break;
+        }
+        occurrences.push_back(occurrence);
+    }
+    if (occurrences.size() > MAX_SERIES_OCCURRENCES) {
+        int day, month, year;
+        civilFromDays(rule.untilDay, day, month, year);
+        error = occurrenceLimitError(std::to_string(day) + "/" + std::to_string(month) + "/" + std::to_string(year));
+        occurrences.clear();
+        return false;
+    }
+    return true;
+}
@@ -3,7 +3,13 @@
 #include <iostream>     // For std::cout, std::cerr, std::endl
 #include <iomanip>      // For std::setw, std::setprecision, etc.
 #include <algorithm>    // For std::sort, std::max, std::min
-#include <cstring>      // For strcmp
+#include <cstdio>       // For std::rename, std::remove, std::snprintf
+#include <sstream>      // For std::ostringstream
+#include "Calendar.h"
+#include "TextFields.h"
+#include "Instrumentation.h"
+#include "FileLock.h"
+#include <climits>      // For LONG_MIN, LONG_MAX
 
 // ANSI Color codes
 const std::string RESET = "\033[0m";
@@ -16,25 +22,48 @@ const std::string CYAN = "\033[36m";
 const std::string WHITE = "\033[37m";
 const std::string BOLD = "\033[1m";
 
-// Constructor
-Scheduler::Scheduler() = default; // Or specific implementation if needed
+// Constructor - the clinic starts with a single chair that accepts every operation
+Scheduler::Scheduler() : resources(1, Resource("Chair1")), journalRecords(0), journalOffset(0), journalLines(0), journalGeneration(0), dayIndex(1) {}
 
 /**
  * @brief Loads dental operations from the specified file.
  */
 bool Scheduler::loadOperations(const std::string& filename) {
+    ScopedTimer timer(Phase::LoadOperations);
     std::ifstream inFile(filename);
     if (!inFile) {
         std::cerr << RED << BOLD << "Error: " << RESET << "Could not open operations file: " << filename << std::endl;
         return false;
     }
-    char op_name[50];
-    float op_price;
-    int op_duration;
-    while (inFile >> op_name >> op_price >> op_duration) { // Format: <name> <price> <duration> [cite: 5]
-        operations.emplace_back(op_name, op_price, op_duration);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(inFile, line)) { // Format: <name> <price> <duration> [cite: 5]
+        ++lineNumber;
+        const char* pos = line.data();
+        const char* end = pos + line.size();
+        std::string_view op_name = nextField(pos, end);
+        if (op_name.empty()) continue; // Blank line
+        float op_price;
+        int op_duration;
+        if (!parseField(nextField(pos, end), op_price) || !parseField(nextField(pos, end), op_duration) || !nextField(pos, end).empty()) {
+            std::cerr << YELLOW << BOLD << "Warning: " << RESET << filename << " line " << lineNumber << ": malformed operation skipped." << std::endl;
+            continue;
+        }
+        if (op_name.size() >= sizeof(Operation().name)) {
+            std::cerr << YELLOW << BOLD << "Warning: " << RESET << filename << " line " << lineNumber << ": operation name is longer than "
+                      << sizeof(Operation().name) - 1 << " characters and was skipped." << std::endl;
+            continue;
+        }
+        if (op_duration < 1 || op_duration > DayOccupancy::MINUTES_PER_DAY) { // Appointment keeps the duration in 16 bits
+            std::cerr << YELLOW << BOLD << "Warning: " << RESET << filename << " line " << lineNumber << ": operation duration must be 1-"
+                      << DayOccupancy::MINUTES_PER_DAY << " minutes; the operation was skipped." << std::endl;
+            continue;
+        }
+        operations.emplace_back(std::string(op_name).c_str(), op_price, op_duration);
+        operationIds.insert(std::make_pair(std::string(operations.back().name), static_cast<int>(operations.size() - 1))); // First entry wins
     }
     inFile.close();
+    rebuildDayIndex(); // The stats columns follow the catalog
     if (operations.empty() && filename == "op_details.txt") { // Check only for the main operations file
          std::cerr << YELLOW << BOLD << "Warning: " << RESET << "No operations loaded from " << filename << ". Please check the file format and content." << std::endl;
     }
@@ -42,67 +71,276 @@ bool Scheduler::loadOperations(const std::string& filename) {
 }
 
 /**
- * @brief Finds an operation by name.
+ * @brief Loads the chairs/dentists and the operations each one can perform.
  */
-const Operation* Scheduler::findOperationByName(const char* opName) const {
-    for (const auto& op : operations) {
-        if (strcmp(op.name, opName) == 0) { // strcmp for C-style strings [cite: 11]
-            return &op;
+bool Scheduler::loadResources(const std::string& filename) {
+    ScopedTimer timer(Phase::LoadResources);
+    std::ifstream inFile(filename);
+    if (!inFile) {
+        return true; // Without a resources file the clinic keeps its single default chair
+    }
+    std::vector<Resource> loaded;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(inFile, line)) { // Format: <name> <operation_name>[,<operation_name>...] or <name> *
+        ++lineNumber;
+        const char* pos = line.data();
+        const char* end = pos + line.size();
+        std::string_view resourceName = nextField(pos, end);
+        if (resourceName.empty()) continue; // Blank line
+        std::string_view operationList = nextField(pos, end);
+        if (operationList.empty() || !nextField(pos, end).empty() || resourceName.size() >= sizeof(Resource().name)) {
+            std::cerr << YELLOW << BOLD << "Warning: " << RESET << filename << " line " << lineNumber << ": malformed resource skipped." << std::endl;
+            continue;
         }
+        Resource resource(std::string(resourceName).c_str());
+        if (operationList != "*") {
+            resource.supported.assign(operations.size(), false);
+            size_t start = 0;
+            while (start <= operationList.size()) {
+                size_t comma = std::min(operationList.find(',', start), operationList.size());
+                std::string opName(operationList.substr(start, comma - start));
+                int opId = findOperationId(opName);
+                if (opId >= 0) {
+                    resource.supported[opId] = true;
+                } else {
+                    std::cerr << YELLOW << BOLD << "Warning: " << RESET << filename << " line " << lineNumber << ": unknown operation '" << opName << "' ignored." << std::endl;
+                }
+                start = comma + 1;
+            }
+        }
+        loaded.push_back(resource);
+    }
+    if (loaded.empty()) {
+        std::cerr << YELLOW << BOLD << "Warning: " << RESET << "No resources loaded from " << filename << ". Using a single chair for all operations." << std::endl;
+        return true;
+    }
+    resources.swap(loaded);
+    rebuildDayIndex();
+    return true;
+}
+
+/**
+ * @brief Finds the ID of a resource by name.
+ */
+int Scheduler::findResourceId(const std::string& resourceName) const {
+    for (size_t i = 0; i < resources.size(); ++i) {
+        if (resourceName == resources[i].name) return static_cast<int>(i);
     }
-    return nullptr;
+    return -1;
+}
+
+/**
+ * @brief Finds the catalog ID of an operation by name.
+ */
+int Scheduler::findOperationId(const std::string& opName) const {
+    auto it = operationIds.find(opName);
+    return it == operationIds.end() ? -1 : it->second;
 }
 
 /**
- * @brief Loads appointments from the specified file.
+ * @brief Resolves the catalog entry of an appointment.
+ */
+const Operation& Scheduler::operationOf(const Appointment& app) const {
+    return operations[app.operationId];
+}
+
+/**
+ * @brief Returns the day index key of a calendar date: its day number, as stored in Appointment::start.
+ */
+long Scheduler::dateKey(int day, int month, int year) {
+    return daysFromCivil(day, month, year);
+}
+
+/**
+ * @brief Marks the minutes covered by an appointment in the day index and adds it to the stats.
+ */
+void Scheduler::indexAppointment(const Appointment& app) {
+    if (app.resourceId < 0 || static_cast<size_t>(app.resourceId) >= dayIndex.size()) return;
+    long dayNumber = app.dayNumber();
+    dayIndex[app.resourceId][dayNumber].mark(app.minuteOfDay(), app.duration);
+    stats.add(dayNumber, app.operationId, app.resourceId, app.duration);
+}
+
+/**
+ * @brief Returns the occupancy of one resource on one day, or nullptr if nothing is booked.
+ */
+const DayOccupancy* Scheduler::occupancy(int resourceId, int day, int month, int year) const {
+    return occupancy(resourceId, dateKey(day, month, year));
+}
+
+/**
+ * @brief Returns the occupancy of one resource on a numbered day, or nullptr if nothing is booked.
+ */
+const DayOccupancy* Scheduler::occupancy(int resourceId, long dayNumber) const {
+    auto it = dayIndex[resourceId].find(dayNumber);
+    return it == dayIndex[resourceId].end() ? nullptr : &it->second;
+}
+
+/**
+ * @brief Returns the first resource that can perform the operation and is free for the whole interval, or -1.
+ */
+int Scheduler::findFreeResource(int day, int month, int year, int start, int duration, int operationId) const {
+    for (size_t r = 0; r < resources.size(); ++r) {
+        if (!resources[r].supports(operationId)) continue;
+        Instrumentation::add(Counter::ResourceProbes);
+        const DayOccupancy* busy = occupancy(static_cast<int>(r), day, month, year);
+        if (!busy || busy->isFree(start, duration)) return static_cast<int>(r);
+    }
+    return -1;
+}
+
+/**
+ * @brief Rebuilds the day index from the appointment list.
+ */
+void Scheduler::rebuildDayIndex() {
+    ScopedTimer timer(Phase::BuildIndex);
+    dayIndex.assign(resources.size(), std::unordered_map<long, DayOccupancy>());
+    stats.reset(operations.size(), resources.size());
+    for (const auto& app : appointments) {
+        indexAppointment(app);
+    }
+}
+
+/**
+ * @brief Returns the journal file that accompanies an appointments snapshot.
+ */
+std::string Scheduler::journalFileName(const std::string& filename) {
+    return filename + ".journal";
+}
+
+/**
+ * @brief Removes one record matching each tombstone from a sorted list; the tombstones without a match are kept.
+ */
+static void applyTombstones(std::vector<Appointment>& records, std::vector<Appointment>& tombstones) {
+    std::vector<bool> removed(records.size(), false);
+    std::vector<Appointment> unmatched;
+    for (const auto& tombstone : tombstones) {
+        auto range = std::equal_range(records.begin(), records.end(), tombstone, Appointment::earlier);
+        auto match = std::find_if(range.first, range.second, [&](const Appointment& app) {
+            return !removed[&app - records.data()] && app.operationId == tombstone.operationId && app.resourceId == tombstone.resourceId;
+        });
+        if (match == range.second) {
+            unmatched.push_back(tombstone);
+        } else {
+            removed[match - records.begin()] = true;
+        }
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (!removed[i]) records[kept++] = records[i];
+    }
+    records.resize(kept);
+    tombstones.swap(unmatched);
+}
+
+/**
+ * @brief Loads appointments from the specified snapshot and replays its journal.
  */
 bool Scheduler::loadAppointments(const std::string& filename) {
     if (operations.empty() && filename == "app_details.txt") {
         std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Operations should be loaded before appointments for proper functionality." << std::endl;
     }
+    // Read before the snapshot: a checkpoint that runs while we load shows up as a new generation at the next refresh
+    journalGeneration = readCounterFile(lockFileName(filename));
+    loadArchiveManifest(filename); // Only the manifest; archived segments are loaded on demand
 
-    std::ifstream inFile(filename);
-    if (!inFile) {
-        // std::cout << "Info: Appointments file " << filename << " was not found or is empty." << std::endl;
-        return true; // It's not an error if the file doesn't exist
+    // The binary snapshot is already sorted; the text snapshot is the fallback.
+    // It's not an error if the snapshot or the journal doesn't exist
+    if (!loadBinarySnapshot(filename)) {
+        readAppointmentRecords(filename, appointments);
     }
+    journalRecords = 0;
+    journalOffset = 0;
+    journalLines = 0;
+    replayJournal(filename, false);
+    // Records before the sealed boundary are left over from an archive run interrupted before its checkpoint
+    appointments.erase(appointments.cbegin(), firstActive());
+    rebuildDayIndex();
+    return true;
+}
 
-    int d, m, y, h, min;
-    char opNameBuffer[50];
-    // Format: <day> <month> <year> <hour> <minute> <operation_name> [cite: 5]
-    while (inFile >> d >> m >> y >> h >> min >> opNameBuffer) {
-        const Operation* opPtr = findOperationByName(opNameBuffer);
-        if (opPtr) {
-            appointments.emplace_back(d, m, y, h, min, *opPtr);
-        } else {
-            std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Operation '" << opNameBuffer << "' from an appointment was not found. Appointment skipped." << std::endl;
+/**
+ * @brief Applies the journal records after journalOffset; when indexed, the day index and stats follow each change.
+ */
+void Scheduler::replayJournal(const std::string& filename, bool indexed) {
+    std::vector<Appointment> journal;
+    std::vector<Appointment> cancelled;
+    if (!readAppointmentRecords(journalFileName(filename), journal, &cancelled, &journalOffset, &journalLines)) {
+        return;
+    }
+    journalRecords += journal.size() + cancelled.size();
+    // A tombstone first cancels a booking made in the same part of the journal; the rest refer to earlier records
+    applyTombstones(journal, cancelled);
+    if (!journal.empty()) {
+        ScopedTimer timer(Phase::ReplayJournal);
+        // A record that is already in the snapshot was folded in by a checkpoint
+        // that was interrupted before the journal could be removed.
+        size_t existing = appointments.size();
+        for (const auto& app : journal) {
+            auto range = std::equal_range(appointments.begin(), appointments.begin() + existing, app, Appointment::earlier);
+            bool folded = std::any_of(range.first, range.second, [&app](const Appointment& other) {
+                return other.operationId == app.operationId && other.resourceId == app.resourceId;
+            });
+            if (!folded) {
+                appointments.push_back(app);
+                if (indexed) indexAppointment(app);
+            }
+        }
+        std::inplace_merge(appointments.begin(), appointments.begin() + existing, appointments.end(), Appointment::earlier);
+    }
+    if (cancelled.empty()) {
+        return;
+    }
+    if (!indexed) {
+        applyTombstones(appointments, cancelled); // A tombstone left without a match was already folded by a checkpoint
+        return;
+    }
+    for (const auto& tombstone : cancelled) {
+        auto range = std::equal_range(appointments.begin(), appointments.end(), tombstone, Appointment::earlier);
+        auto match = std::find_if(range.first, range.second, [&tombstone](const Appointment& app) {
+            return app.operationId == tombstone.operationId && app.resourceId == tombstone.resourceId;
+        });
+        if (match != range.second) {
+            unindexAppointment(match);
+            appointments.erase(match);
         }
     }
-    inFile.close();
-    std::sort(this->appointments.begin(), this->appointments.end(), [](const Appointment& a, const Appointment& b){
-        if (a.year != b.year) return a.year < b.year;
-        if (a.month != b.month) return a.month < b.month;
-        if (a.day != b.day) return a.day < b.day;
-        if (a.hour != b.hour) return a.hour < b.hour;
-        return a.minute < b.minute;
-    });
-    return true;
+}
+
+/**
+ * @brief Writes one appointment as a text record.
+ */
+void Scheduler::writeRecord(std::ostream& out, const Appointment& app) const {
+    // Format: <day> <month> <year> <hour> <minute> <operation_name> [resource_name] [cite: 5]
+    // The resource is only written when the clinic has more than one, so single-chair files keep the original format
+    int day, month, year;
+    app.date(day, month, year);
+    out << day << " " << month << " " << year << " "
+        << app.hour() << " " << app.minute() << " " << operationOf(app).name;
+    if (resources.size() > 1) {
+        out << " " << resources[app.resourceId].name;
+    }
+    out << '\n';
 }
 
 /**
  * @brief Saves all current appointments to the specified file.
  */
 bool Scheduler::saveAppointments(const std::string& filename) const {
+    ScopedTimer timer(Phase::SaveRecords);
     std::ofstream outFile(filename);
     if (!outFile) {
         std::cerr << RED << BOLD << "Error: " << RESET << "Could not open appointments file for saving: " << filename << std::endl;
         return false;
     }
-    for (const auto& app : appointments) {
-        // Format: <day> <month> <year> <hour> <minute> <operation_name> [cite: 5]
-        outFile << app.day << " " << app.month << " " << app.year << " "
-                << app.hour << " " << app.minute << " " << app.operation.name << std::endl;
+    // Archived appointments that were loaded on demand stay in their segments
+    auto first = firstActive();
+    for (auto it = first; it != appointments.cend(); ++it) {
+        writeRecord(outFile, *it);
     }
+    Instrumentation::add(Counter::RecordsWritten, static_cast<uint64_t>(appointments.cend() - first));
+    Instrumentation::add(Counter::BytesWritten, static_cast<uint64_t>(std::max<std::streamoff>(0, outFile.tellp())));
     outFile.close();
     if (outFile.fail()) {
          std::cerr << RED << BOLD << "Error: " << RESET << "Could not write all data to appointments file: " << filename << std::endl;
@@ -111,31 +349,129 @@ bool Scheduler::saveAppointments(const std::string& filename) const {
     return true;
 }
 
+/**
+ * @brief Appends a single appointment record to the journal of the specified snapshot.
+ */
+bool Scheduler::appendAppointment(const std::string& filename, const Appointment& app) {
+    return appendAppointments(filename, std::vector<Appointment>(1, app));
+}
+
+/**
+ * @brief Appends several appointment records to the journal with a single write.
+ */
+bool Scheduler::appendAppointments(const std::string& filename, const std::vector<Appointment>& apps) {
+    ScopedTimer timer(Phase::AppendJournal);
+    std::ostringstream records;
+    for (const auto& app : apps) {
+        writeRecord(records, app);
+    }
+    return appendJournal(filename, records.str(), apps.size());
+}
+
+/**
+ * @brief Appends a tombstone for a cancelled appointment, followed by its replacement when it was moved.
+ */
+bool Scheduler::appendCancellation(const std::string& filename, const Appointment& cancelled, const Appointment* replacement) {
+    ScopedTimer timer(Phase::AppendJournal);
+    std::ostringstream records;
+    records << "CANCEL ";
+    writeRecord(records, cancelled);
+    if (replacement) {
+        writeRecord(records, *replacement);
+    }
+    return appendJournal(filename, records.str(), replacement ? 2 : 1);
+}
+
+/**
+ * @brief Appends already formatted records to the journal with a single write.
+ */
+bool Scheduler::appendJournal(const std::string& filename, const std::string& records, size_t count) {
+    std::ofstream outFile(journalFileName(filename), std::ios::app);
+    if (!outFile) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not open appointments journal: " << journalFileName(filename) << std::endl;
+        return false;
+    }
+    outFile << records;
+    outFile.close();
+    if (outFile.fail()) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not append to appointments journal: " << journalFileName(filename) << std::endl;
+        return false;
+    }
+    journalRecords += count;
+    journalOffset += records.size(); // Under the journal lock nothing else was appended since the last read
+    journalLines += static_cast<size_t>(std::count(records.begin(), records.end(), '\n'));
+    Instrumentation::add(Counter::RecordsWritten, count);
+    Instrumentation::add(Counter::BytesWritten, records.size());
+    return true;
+}
+
+/**
+ * @brief Folds the journal into a fresh snapshot and removes the journal.
+ * Other processes may be writing, so it runs inside a JournalTransaction.
+ */
+bool Scheduler::checkpointAppointments(const std::string& filename, bool buildSnapshot) {
+    const std::string tempFilename = filename + ".tmp";
+    if (!saveAppointments(tempFilename) || !syncFile(tempFilename)) { // The snapshot is durable before the journal goes
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(filename.c_str()); // std::rename does not replace an existing file there
+#endif
+    // On POSIX the rename is atomic, so a concurrent reader sees either the old or the new snapshot
+    if (std::rename(tempFilename.c_str(), filename.c_str()) != 0) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not replace appointments file: " << filename << std::endl;
+        return false;
+    }
+    std::remove(journalFileName(filename).c_str());
+    resetGroupCommit(journalFileName(filename));
+    journalRecords = 0;
+    journalOffset = 0;
+    journalLines = 0;
+    // Processes that loaded the old snapshot reload it at their next refresh
+    journalGeneration = readCounterFile(lockFileName(filename)) + 1;
+    writeCounterFile(lockFileName(filename), journalGeneration);
+
+    // Keep an existing binary snapshot in step with the new text snapshot; build_snapshot asks for one either way
+    if (!buildSnapshot) {
+        std::ifstream binaryFile(binarySnapshotFileName(filename));
+        buildSnapshot = static_cast<bool>(binaryFile);
+    }
+    return !buildSnapshot || saveBinarySnapshot(filename);
+}
+
+/**
+ * @brief Returns the number of records currently in the journal.
+ */
+size_t Scheduler::journalSize() const {
+    return journalRecords;
+}
+
 /**
  * @brief Displays the list of available dental operations.
  */
-void Scheduler::displayOperations() const {
+void Scheduler::displayOperations(std::ostream& out) const {
     if (operations.empty()) {
-        std::cout << YELLOW << BOLD << "No dental operations available." << RESET << std::endl;
+        out << YELLOW << BOLD << "No dental operations available." << RESET << std::endl;
         return;
     }
-    std::cout << CYAN << BOLD << "\nAvailable Dental Operations:" << RESET << std::endl;
-    std::cout << BLUE << "-----------------------------------------------------------------" << RESET << std::endl;
-    std::cout << std::left
+    out << CYAN << BOLD << "\nAvailable Dental Operations:" << RESET << std::endl;
+    out << BLUE << "-----------------------------------------------------------------" << RESET << std::endl;
+    out << std::left
               << MAGENTA << BOLD << std::setw(5) << "No."
               << std::setw(25) << "Operation Name"
               << std::setw(15) << "Price (RON)"
               << std::setw(15) << "Duration (min)" << RESET << std::endl;
-    std::cout << BLUE << "-----------------------------------------------------------------" << RESET << std::endl;
+    out << BLUE << "-----------------------------------------------------------------" << RESET << std::endl;
     int index = 1;
     for (const auto& op : operations) {
-        std::cout << std::left
+        out << std::left
                   << WHITE << std::setw(5) << index++
                   << GREEN << std::setw(25) << op.name
                   << YELLOW << std::fixed << std::setprecision(2) << std::setw(15) << op.price
                   << CYAN << std::setw(15) << op.duration << RESET << std::endl;
     }
-    std::cout << BLUE << "-----------------------------------------------------------------" << RESET << "\n" << std::endl;
+    out << BLUE << "-----------------------------------------------------------------" << RESET << "\n" << std::endl;
 }
 
 /**
@@ -149,16 +485,12 @@ bool Scheduler::isSlotAvailable(int day, int month, int year, int hour, int minu
         return false; 
     }
 
-    for (const auto& existingApp : appointments) {
-        if (existingApp.day == day && existingApp.month == month && existingApp.year == year) {
-            int existingAppStartMinutes = existingApp.hour * 60 + existingApp.minute;
-            int existingAppEndMinutes = existingAppStartMinutes + existingApp.operation.duration;
-            if (std::max(newAppStartMinutes, existingAppStartMinutes) < std::min(newAppEndMinutes, existingAppEndMinutes)) {
-                return false; 
-            }
-        }
+    // The slot is available if at least one chair/dentist is free for the whole interval
+    for (size_t r = 0; r < resources.size(); ++r) {
+        const DayOccupancy* busy = occupancy(static_cast<int>(r), day, month, year);
+        if (!busy || busy->isFree(newAppStartMinutes, operationDuration)) return true;
     }
-    return true; 
+    return false;
 }
 
 /**
@@ -168,104 +500,424 @@ bool Scheduler::isExactMinuteAvailable(int day, int month, int year, int hour, i
     int checkTimeInMinutes = hour * 60 + minute;
     if (hour < 0 || hour > 23 || minute < 0 || minute > 59) return false;
 
-    for (const auto& app : appointments) {
-        if (app.day == day && app.month == month && app.year == year) {
-            int appStartMinutes = app.hour * 60 + app.minute;
-            int appEndMinutes = appStartMinutes + app.operation.duration;
-            if (checkTimeInMinutes >= appStartMinutes && checkTimeInMinutes < appEndMinutes) {
-                return false; 
-            }
-        }
+    for (size_t r = 0; r < resources.size(); ++r) {
+        const DayOccupancy* busy = occupancy(static_cast<int>(r), day, month, year);
+        if (!busy || busy->isMinuteFree(checkTimeInMinutes)) return true;
     }
-    return true;
+    return false;
+}
+
+/**
+ * @brief Reports whether an exact minute is free, in the format used by check_availability.
+ */
+void Scheduler::reportMinuteAvailability(int day, int month, int year, int hour, int minute, std::ostream& out) const {
+    if (isExactMinuteAvailable(day, month, year, hour, minute)) {
+        out << GREEN << BOLD << "Time slot (time "
+            << std::setfill('0') << std::setw(2) << hour << ":"
+            << std::setfill('0') << std::setw(2) << minute
+            << " on " << day << "/" << month << "/" << year
+            << ") is AVAILABLE" << RESET << GREEN << " (exact minute is not covered)." << RESET << std::endl;
+    } else {
+        out << RED << BOLD << "Time slot (time "
+            << std::setfill('0') << std::setw(2) << hour << ":"
+            << std::setfill('0') << std::setw(2) << minute
+            << " on " << day << "/" << month << "/" << year
+            << ") is NOT AVAILABLE" << RESET << RED << " (exact minute is covered)." << RESET << std::endl;
+    }
+    out << std::setfill(' '); // Reset fill character
+}
+
+/**
+ * @brief Checks whether a booking request can be placed in the calendar.
+ */
+BookingStatus Scheduler::checkBooking(const BookingRequest& request, int* resourceId) const {
+    ScopedTimer timer(Phase::SlotCheck);
+    Instrumentation::add(Counter::SlotChecks);
+    if (request.operation_number <= 0 || static_cast<size_t>(request.operation_number) > operations.size()) {
+        return BookingStatus::InvalidOperation;
+    }
+    if (!isValidDate(request.day, request.month, request.year) || request.year < FIRST_BOOKABLE_YEAR || request.year > LAST_BOOKABLE_YEAR ||
+        request.hour < 0 || request.hour > 23 || request.minute < 0 || request.minute > 59) {
+        return BookingStatus::InvalidDateTime;
+    }
+    if (archive.sealedBefore != LONG_MIN && daysFromCivil(request.day, request.month, request.year) < archive.sealedBefore) {
+        return BookingStatus::Archived;
+    }
+    int duration = operations[request.operation_number - 1].duration;
+    if (request.hour * 60 + request.minute + duration > 24 * 60) {
+        return BookingStatus::PastMidnight;
+    }
+    int operationId = request.operation_number - 1;
+    bool compatible = false;
+    for (const auto& resource : resources) {
+        compatible = compatible || resource.supports(operationId);
+    }
+    if (!compatible) {
+        return BookingStatus::NoResource;
+    }
+    int freeResource = findFreeResource(request.day, request.month, request.year, request.hour * 60 + request.minute, duration, operationId);
+    if (freeResource < 0) {
+        return BookingStatus::SlotTaken;
+    }
+    if (resourceId) {
+        *resourceId = freeResource;
+    }
+    return BookingStatus::Accepted;
 }
 
 /**
  * @brief Schedules a new appointment.
  */
-bool Scheduler::scheduleAppointment(int day, int month, int year, int hour, int minute, int operation_number) {
-    if (operation_number <= 0 || static_cast<size_t>(operation_number) > operations.size()) {
-        std::cerr << RED << BOLD << "Error: " << RESET << "Invalid operation number." << std::endl;
-        displayOperations(); 
+bool Scheduler::scheduleAppointment(int day, int month, int year, int hour, int minute, int operation_number, Appointment* scheduled,
+                                    std::ostream& out, std::ostream& err) {
+    ScopedTimer timer(Phase::Schedule);
+    int resourceId = 0;
+    BookingStatus status = checkBooking(BookingRequest{day, month, year, hour, minute, operation_number}, &resourceId);
+    if (status == BookingStatus::InvalidOperation) {
+        err << RED << BOLD << "Error: " << RESET << "Invalid operation number." << std::endl;
+        displayOperations(out); 
+        return false;
+    }
+    if (status == BookingStatus::InvalidDateTime) {
+        err << RED << BOLD << "Error: " << RESET << "Invalid date or time for appointment." << std::endl;
+        return false;
+    }
+    if (status == BookingStatus::Archived) {
+        err << RED << BOLD << "Error: " << RESET << "Appointments before the archived boundary cannot be scheduled." << std::endl;
         return false;
     }
 
     const Operation& selectedOp = operations[operation_number - 1]; 
 
-    if (month < 1 || month > 12 || day < 1 || day > 31 || year < 2024 || year > 2050 ||
-        hour < 0 || hour > 23 || minute < 0 || minute > 59) {
-        std::cerr << RED << BOLD << "Error: " << RESET << "Invalid date or time for appointment." << std::endl;
-        return false;
-    }
-    
-    int proposedEndTimeMinutes = hour * 60 + minute + selectedOp.duration;
-    if (proposedEndTimeMinutes > 24*60) {
-        std::cout << RED << BOLD << "Appointment for '" << selectedOp.name << "' on "
+    if (status == BookingStatus::PastMidnight) {
+        out << RED << BOLD << "Appointment for '" << selectedOp.name << "' on "
                   << day << "/" << month << "/" << year << " at "
                   << std::setfill('0') << std::setw(2) << hour << ":"
                   << std::setfill('0') << std::setw(2) << minute
                   << " cannot be scheduled (extends past midnight)." << RESET << std::endl;
-        std::cout << std::setfill(' '); 
+        out << std::setfill(' '); 
         return false;
     }
 
-    if (!isSlotAvailable(day, month, year, hour, minute, selectedOp.duration)) {
-        std::cout << RED << BOLD << "Time slot " << day << "/" << month << "/" << year
+    if (status == BookingStatus::SlotTaken || status == BookingStatus::NoResource) {
+        out << RED << BOLD << "Time slot " << day << "/" << month << "/" << year
                   << " at " << std::setfill('0') << std::setw(2) << hour << ":"
                   << std::setfill('0') << std::setw(2) << minute
                   << " for '" << selectedOp.name << "' (duration " << selectedOp.duration
                   << " min) is not available." << RESET << std::endl;
-        std::cout << std::setfill(' '); 
+        out << std::setfill(' '); 
         return false;
     }
 
-    appointments.emplace_back(day, month, year, hour, minute, selectedOp);
-    std::cout << GREEN << BOLD << "Appointment scheduled: '" << selectedOp.name
+    Appointment newApp(day, month, year, hour, minute, operation_number - 1, resourceId, selectedOp.duration);
+    auto pos = std::upper_bound(appointments.begin(), appointments.end(), newApp, Appointment::earlier);
+    auto inserted = appointments.insert(pos, std::move(newApp));
+    indexAppointment(*inserted);
+    if (scheduled) {
+        *scheduled = *inserted;
+    }
+    out << GREEN << BOLD << "Appointment scheduled: '" << selectedOp.name
               << "' on " << day << "/" << month << "/" << year
               << " at " << std::setfill('0') << std::setw(2) << hour << ":"
-              << std::setfill('0') << std::setw(2) << minute << "." << RESET << std::endl;
-    std::cout << std::setfill(' '); 
-
-    std::sort(this->appointments.begin(), this->appointments.end(), [](const Appointment& a, const Appointment& b){
-        if (a.year != b.year) return a.year < b.year;
-        if (a.month != b.month) return a.month < b.month;
-        if (a.day != b.day) return a.day < b.day;
-        if (a.hour != b.hour) return a.hour < b.hour;
-        return a.minute < b.minute;
-    });
+              << std::setfill('0') << std::setw(2) << minute;
+    if (resources.size() > 1) {
+        out << " with " << resources[resourceId].name;
+    }
+    out << "." << RESET << std::endl;
+    out << std::setfill(' '); 
 
     return true;
 }
 
+/**
+ * @brief Schedules many requests in one pass; each is checked against the calendar and the requests accepted before it.
+ */
+std::vector<BookingStatus> Scheduler::scheduleBatch(const std::vector<BookingRequest>& requests, std::vector<Appointment>* scheduled) {
+    ScopedTimer timer(Phase::Schedule);
+    std::vector<BookingStatus> results;
+    results.reserve(requests.size());
+    std::vector<Appointment> accepted;
+    for (const auto& request : requests) {
+        int resourceId = 0;
+        BookingStatus status = checkBooking(request, &resourceId);
+        if (status == BookingStatus::Accepted) {
+            accepted.emplace_back(request.day, request.month, request.year, request.hour, request.minute,
+                                  request.operation_number - 1, resourceId, operations[request.operation_number - 1].duration);
+            indexAppointment(accepted.back()); // Later requests in the batch see this booking
+        }
+        results.push_back(status);
+    }
+
+    std::sort(accepted.begin(), accepted.end(), Appointment::earlier);
+    size_t existing = appointments.size();
+    appointments.insert(appointments.end(), accepted.begin(), accepted.end());
+    std::inplace_merge(appointments.begin(), appointments.begin() + existing, appointments.end(), Appointment::earlier);
+    if (scheduled) {
+        *scheduled = std::move(accepted);
+    }
+    return results;
+}
+
+/**
+ * @brief Finds the first free, non-overlapping slots for an operation between two days (inclusive).
+ */
+std::vector<BookingRequest> Scheduler::findFreeSlots(int operation_number, long firstDay, long lastDay, size_t count) const {
+    ScopedTimer timer(Phase::FindSlots);
+    std::vector<BookingRequest> slots;
+    if (operation_number <= 0 || static_cast<size_t>(operation_number) > operations.size()) {
+        return slots;
+    }
+    int operationId = operation_number - 1;
+    int duration = operations[operationId].duration;
+    firstDay = std::max(firstDay, archive.sealedBefore); // Archived days cannot be booked
+    const DayOccupancy freeDay;
+    std::vector<const DayOccupancy*> compatible;
+    for (long dayNumber = firstDay; dayNumber <= lastDay && slots.size() < count; ++dayNumber) {
+        int day, month, year;
+        civilFromDays(dayNumber, day, month, year);
+        compatible.clear();
+        for (size_t r = 0; r < resources.size(); ++r) {
+            if (!resources[r].supports(operationId)) continue;
+            const DayOccupancy* busy = occupancy(static_cast<int>(r), day, month, year);
+            compatible.push_back(busy ? busy : &freeDay);
+        }
+        // Earliest start on any compatible resource, then continue after that slot ends
+        int from = 0;
+        while (slots.size() < count) {
+            int start = -1;
+            for (const DayOccupancy* busy : compatible) {
+                int candidate = busy->findFreeRun(from, duration);
+                if (candidate >= 0 && (start < 0 || candidate < start)) start = candidate;
+            }
+            if (start < 0) break;
+            slots.push_back(BookingRequest{day, month, year, start / 60, start % 60, operation_number});
+            from = start + std::max(duration, 1);
+        }
+    }
+    return slots;
+}
+
 /**
  * @brief Displays the history of all appointments.
  */
-void Scheduler::displayAppointmentHistory() const {
-    if (appointments.empty()) {
-        std::cout << YELLOW << BOLD << "No appointments in history." << RESET << std::endl;
-        return;
+void Scheduler::displayAppointmentHistory(std::ostream& out) const {
+    displayAppointmentHistory(HistoryQuery(), out);
+}
+
+/**
+ * @brief Appends a number left-padded with zeros to the given width.
+ */
+static void appendPadded(std::string& buffer, int value, int width) {
+    if (value < 0) {
+        buffer += '-';
+        value = -value;
+        --width;
     }
-    std::cout << CYAN << BOLD << "\nAppointment History:" << RESET << std::endl;
-    std::cout << BLUE << "------------------------------------------------------------------------------------" << RESET << std::endl;
-    std::cout << std::left
-              << MAGENTA << BOLD << std::setw(12) << "Date"
-              << std::setw(8) << "Time"
-              << std::setw(25) << "Operation"
-              << std::setw(15) << "Price (RON)"
-              << std::setw(15) << "Duration (min)" << RESET << std::endl;
-    std::cout << BLUE << "------------------------------------------------------------------------------------" << RESET << std::endl;
+    char digits[16];
+    int length = 0;
+    do {
+        digits[length++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0 && length < 15);
+    for (int i = length; i < width; ++i) buffer += '0';
+    while (length > 0) buffer += digits[--length];
+}
 
-    for (const auto& app : appointments) {
-        std::cout << std::left
-                  << WHITE << std::setfill('0') << std::setw(2) << app.day << "/"
-                  << std::setfill('0') << std::setw(2) << app.month << "/"
-                  << std::setw(4) << app.year << std::setfill(' ') << "  " 
-                  << CYAN << std::setfill('0') << std::setw(2) << app.hour << ":"
-                  << std::setfill('0') << std::setw(2) << app.minute << std::setfill(' ') << "   " 
-                  << GREEN << std::setw(25) << app.operation.name
-                  << YELLOW << std::fixed << std::setprecision(2) << std::setw(15) << app.operation.price
-                  << MAGENTA << std::setw(15) << app.operation.duration << RESET << std::endl;
-    }
-    std::cout << BLUE << "------------------------------------------------------------------------------------" << RESET << "\n" << std::endl;
-    std::cout << std::setfill(' ');
-}
\ No newline at end of file
+/**
+ * @brief Appends text left-justified in a column of the given width.
+ */
+static void appendColumn(std::string& buffer, const std::string& text, size_t width) {
+    buffer += text;
+    if (text.size() < width) buffer.append(width - text.size(), ' ');
+}
+
+/**
+ * @brief Returns text as a JSON string body, escaping quotes, backslashes and control characters.
+ */
+static std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned char>(c));
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Returns text as a CSV field, quoted (with inner quotes doubled) when it holds a comma, a quote or a line break.
+ */
+static std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (char c : text) {
+        quoted += c;
+        if (c == '"') quoted += '"';
+    }
+    return quoted + "\"";
+}
+
+/**
+ * @brief Displays the appointments matching a query; the date range is located by binary search.
+ */
+bool Scheduler::displayAppointmentHistory(const HistoryQuery& query, std::ostream& out) const {
+    ScopedTimer timer(Phase::Output);
+    int operationFilter = -1;
+    if (!query.operation.empty()) {
+        int number;
+        operationFilter = findOperationId(query.operation);
+        if (operationFilter < 0 && parseField(query.operation, number) && number >= 1 && static_cast<size_t>(number) <= operations.size()) {
+            operationFilter = number - 1; // Operation number as shown by view_operations
+        }
+        if (operationFilter < 0) {
+            out << RED << BOLD << "Error: " << RESET << "Unknown operation '" << query.operation << "'." << std::endl;
+            return false;
+        }
+    }
+
+    // Appointments are sorted by start, so the date range is a contiguous slice
+    auto first = appointments.begin();
+    auto last = appointments.end();
+    int day, month, year;
+    if (query.fromDay != LONG_MIN) {
+        civilFromDays(query.fromDay, day, month, year);
+        first = std::lower_bound(appointments.begin(), appointments.end(), Appointment(day, month, year, 0, 0, -1), Appointment::earlier);
+    }
+    if (query.toDay != LONG_MAX) {
+        civilFromDays(query.toDay + 1, day, month, year);
+        last = std::lower_bound(first, appointments.end(), Appointment(day, month, year, 0, 0, -1), Appointment::earlier);
+    }
+    if (last < first) last = first;
+
+    const bool table = query.format == HistoryFormat::Table;
+    const bool json = query.format == HistoryFormat::Json;
+    const bool resourceColumn = resources.size() > 1; // A single-chair clinic keeps the original table
+    const std::string rule = resourceColumn
+        ? "----------------------------------------------------------------------------------------------------"
+        : "------------------------------------------------------------------------------------";
+    std::string buffer;
+    buffer.reserve(1 << 16);
+    if (table) {
+        buffer += CYAN + BOLD + "\nAppointment History:" + RESET + "\n";
+        buffer += BLUE + rule + RESET + "\n";
+        buffer += MAGENTA + BOLD;
+        appendColumn(buffer, "Date", 12);
+        appendColumn(buffer, "Time", 8);
+        appendColumn(buffer, "Operation", 25);
+        appendColumn(buffer, "Price (RON)", 15);
+        appendColumn(buffer, "Duration (min)", 15);
+        if (resourceColumn) appendColumn(buffer, "Resource", 16);
+        buffer += RESET + "\n" + BLUE + rule + RESET + "\n";
+    } else if (json) {
+        buffer += "[";
+    } else {
+        buffer += "date,time,operation,price,duration,resource\n";
+    }
+
+    // The operation and resource columns only depend on the catalog, so they are formatted once per entry
+    std::vector<std::string> operationCells(operations.size());
+    for (size_t i = 0; i < operations.size(); ++i) {
+        char price[32];
+        std::snprintf(price, sizeof(price), "%.2f", operations[i].price);
+        std::string& cell = operationCells[i];
+        if (table) {
+            cell = "   " + GREEN;
+            appendColumn(cell, operations[i].name, 25);
+            cell += YELLOW;
+            appendColumn(cell, price, 15);
+            cell += MAGENTA;
+            appendColumn(cell, std::to_string(operations[i].duration), 15);
+        } else if (json) {
+            cell = std::string("\",\"operation\":\"") + jsonEscape(operations[i].name) + "\",\"price\":" + price +
+                   ",\"duration\":" + std::to_string(operations[i].duration);
+        } else {
+            cell = "," + csvField(operations[i].name) + "," + price + "," + std::to_string(operations[i].duration);
+        }
+    }
+    std::vector<std::string> resourceCells(resources.size());
+    for (size_t i = 0; i < resources.size(); ++i) {
+        std::string& cell = resourceCells[i];
+        if (table) {
+            if (resourceColumn) {
+                cell = CYAN;
+                appendColumn(cell, resources[i].name, 16);
+            }
+            cell += RESET + "\n";
+        } else if (json) {
+            cell = std::string(",\"resource\":\"") + jsonEscape(resources[i].name) + "\"}";
+        } else {
+            cell = "," + csvField(resources[i].name) + "\n";
+        }
+    }
+
+    size_t skipped = 0;
+    size_t shown = 0;
+    long shownDay = LONG_MIN; // The calendar date is derived once per day, since rows are sorted
+    for (auto it = first; it != last && shown < query.limit; ++it) {
+        if (operationFilter >= 0 && it->operationId != operationFilter) continue;
+        if (skipped < query.offset) {
+            ++skipped;
+            continue;
+        }
+        if (it->dayNumber() != shownDay) {
+            shownDay = it->dayNumber();
+            civilFromDays(shownDay, day, month, year);
+        }
+        const int minuteOfDay = it->minuteOfDay();
+        if (table) {
+            buffer += WHITE;
+            appendPadded(buffer, day, 2);
+            buffer += '/';
+            appendPadded(buffer, month, 2);
+            buffer += '/';
+            appendPadded(buffer, year, 4);
+            buffer += "  ";
+            buffer += CYAN;
+            appendPadded(buffer, minuteOfDay / 60, 2);
+            buffer += ':';
+            appendPadded(buffer, minuteOfDay % 60, 2);
+        } else {
+            if (json) buffer += shown ? ",\n{\"date\":\"" : "\n{\"date\":\"";
+            appendPadded(buffer, year, 4);
+            buffer += '-';
+            appendPadded(buffer, month, 2);
+            buffer += '-';
+            appendPadded(buffer, day, 2);
+            buffer += json ? "\",\"time\":\"" : ",";
+            appendPadded(buffer, minuteOfDay / 60, 2);
+            buffer += ':';
+            appendPadded(buffer, minuteOfDay % 60, 2);
+        }
+        buffer += operationCells[it->operationId];
+        buffer += resourceCells[it->resourceId];
+        ++shown;
+        if (buffer.size() >= (1 << 16) - 256) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+
+    Instrumentation::add(Counter::RowsDisplayed, shown);
+    if (table) {
+        if (shown == 0) {
+            out << YELLOW << BOLD << "No appointments in history." << RESET << std::endl;
+            return true;
+        }
+        buffer += BLUE + rule + RESET + "\n\n";
+    } else if (json) {
+        buffer += shown ? "\n]\n" : "]\n";
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+    return true;
+}
@@ -0,0 +1,276 @@
+#include "Scheduler.h"
+#include "Calendar.h"
+#include "Instrumentation.h"
+#include <fstream>      // For std::ifstream, std::ofstream
+#include <iostream>     // For std::cerr, std::endl
+#include <sstream>      // For std::ostringstream
+#include <iomanip>      // For std::setw, std::setfill
+#include <algorithm>    // For std::lower_bound, std::inplace_merge, std::sort
+#include <cstdio>       // For std::rename, std::remove
+#include <filesystem>   // For std::filesystem::create_directories
+
+// ANSI Color codes
+const std::string RESET = "\033[0m";
+const std::string RED = "\033[31m";
+const std::string YELLOW = "\033[33m";
+const std::string BOLD = "\033[1m";
+
+/**
+ * @brief Returns the archive directory that accompanies an appointments file.
+ */
+std::string Scheduler::archiveDirectoryName(const std::string& filename) {
+    return filename + ".archive";
+}
+
+/**
+ * @brief Formats a day number as d/m/y for the manifest.
+ */
+static std::string manifestDate(long dayNumber) {
+    int day, month, year;
+    civilFromDays(dayNumber, day, month, year);
+    return std::to_string(day) + "/" + std::to_string(month) + "/" + std::to_string(year);
+}
+
+/**
+ * @brief Replaces a file with new content through a temporary file.
+ */
+static bool replaceFile(const std::string& filename, const std::string& content) {
+    const std::string tempFilename = filename + ".tmp";
+    std::ofstream outFile(tempFilename, std::ios::binary);
+    if (!outFile) {
+        return false;
+    }
+    outFile << content;
+    outFile.close();
+    if (outFile.fail()) {
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(filename.c_str()); // std::rename does not replace an existing file there
+#endif
+    return std::rename(tempFilename.c_str(), filename.c_str()) == 0;
+}
+
+/**
+ * @brief Keeps the first records lines of a segment: the ones its manifest entry counts.
+ * Lines past them were written by an archive run that stopped before its manifest update.
+ */
+static std::string committedRecords(const std::string& content, size_t records) {
+    size_t end = 0;
+    for (size_t kept = 0; kept < records && end < content.size(); ++kept) {
+        size_t lineEnd = content.find('\n', end);
+        end = lineEnd == std::string::npos ? content.size() : lineEnd + 1;
+    }
+    return content.substr(0, end);
+}
+
+/**
+ * @brief Reads the archive manifest of an appointments file; a missing manifest means nothing is archived.
+ */
+bool Scheduler::loadArchiveManifest(const std::string& filename) {
+    archiveDirectory = archiveDirectoryName(filename);
+    archive = ArchiveManifest();
+    std::ifstream inFile(archiveDirectory + "/manifest.txt");
+    if (!inFile) {
+        return true;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(inFile, line)) {
+        ++lineNumber;
+        std::istringstream fields(line);
+        std::string name, first, last, extra;
+        int day, month, year;
+        if (!(fields >> name)) continue; // Blank line
+        if (name == "sealed_before") {
+            if (fields >> first && !(fields >> extra) && parseDate(first, day, month, year)) {
+                archive.sealedBefore = daysFromCivil(day, month, year);
+                continue;
+            }
+        } else {
+            ArchiveSegment segment;
+            segment.name = name;
+            if (fields >> first >> last >> segment.records && !(fields >> extra) && parseDate(first, day, month, year)) {
+                segment.firstDay = daysFromCivil(day, month, year);
+                if (parseDate(last, day, month, year)) {
+                    segment.lastDay = daysFromCivil(day, month, year);
+                    archive.segments.push_back(segment);
+                    continue;
+                }
+            }
+        }
+        std::cerr << YELLOW << BOLD << "Warning: " << RESET << archiveDirectory << "/manifest.txt line " << lineNumber << ": malformed entry skipped." << std::endl;
+    }
+    std::sort(archive.segments.begin(), archive.segments.end(), [](const ArchiveSegment& a, const ArchiveSegment& b) {
+        return a.firstDay < b.firstDay;
+    });
+    return true;
+}
+
+/**
+ * @brief Writes the archive manifest.
+ */
+bool Scheduler::saveArchiveManifest() const {
+    std::ostringstream manifest;
+    manifest << "sealed_before " << manifestDate(archive.sealedBefore) << '\n';
+    for (const auto& segment : archive.segments) {
+        manifest << segment.name << " " << manifestDate(segment.firstDay) << " " << manifestDate(segment.lastDay) << " " << segment.records << '\n';
+    }
+    if (!replaceFile(archiveDirectory + "/manifest.txt", manifest.str())) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not write archive manifest: " << archiveDirectory << "/manifest.txt" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the first appointment on or after the sealed boundary; only these live in the active file.
+ */
+std::vector<Appointment>::const_iterator Scheduler::firstActive() const {
+    if (archive.sealedBefore == LONG_MIN) {
+        return appointments.begin();
+    }
+    int day, month, year;
+    civilFromDays(archive.sealedBefore, day, month, year);
+    return std::lower_bound(appointments.begin(), appointments.end(), Appointment(day, month, year, 0, 0, -1), Appointment::earlier);
+}
+
+/**
+ * @brief Returns the first day that is not archived, or LONG_MIN if nothing is.
+ */
+long Scheduler::sealedBefore() const {
+    return archive.sealedBefore;
+}
+
+/**
+ * @brief Checks whether every archived segment that overlaps a range of days is already in memory.
+ */
+bool Scheduler::isArchiveLoaded(long fromDay, long toDay) const {
+    for (const auto& segment : archive.segments) {
+        if (!segment.loaded && segment.lastDay >= fromDay && segment.firstDay <= toDay) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Loads the archived segments that overlap a range of days and are not in memory yet.
+ */
+bool Scheduler::loadArchivedRange(long fromDay, long toDay) {
+    if (isArchiveLoaded(fromDay, toDay)) {
+        return true;
+    }
+    ScopedTimer timer(Phase::ParseRecords);
+    std::vector<Appointment> loaded;
+    bool complete = true;
+    for (auto& segment : archive.segments) {
+        if (segment.loaded || segment.lastDay < fromDay || segment.firstDay > toDay) continue;
+        const std::string segmentFilename = archiveDirectory + "/" + segment.name + ".txt";
+        std::vector<Appointment> records;
+        if (!readAppointmentRecords(segmentFilename, records)) {
+            std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Archived segment " << segmentFilename << " could not be read." << std::endl;
+            complete = false;
+        }
+        // Records past the manifest count belong to an interrupted archive run; each run only adds later days,
+        // so they sort after the committed ones and are still in the active file
+        if (records.size() > segment.records) {
+            records.resize(segment.records);
+        }
+        loaded.insert(loaded.end(), records.begin(), records.end());
+        segment.loaded = true; // A missing segment is reported once
+    }
+    // The segments are disjoint months in manifest order, so loaded is already sorted
+    size_t existing = appointments.size();
+    appointments.insert(appointments.end(), loaded.begin(), loaded.end());
+    std::inplace_merge(appointments.begin(), appointments.begin() + existing, appointments.end(), Appointment::earlier);
+    for (const auto& app : loaded) {
+        indexAppointment(app);
+    }
+    return complete;
+}
+
+/**
+ * @brief Moves every appointment before a day into sealed monthly segments and shrinks the active file.
+ */
+bool Scheduler::archiveAppointments(const std::string& filename, long beforeDay, size_t& archived) {
+    archived = 0;
+    if (archiveDirectory.empty()) {
+        loadArchiveManifest(filename);
+    }
+    if (beforeDay <= archive.sealedBefore) {
+        return true; // Already sealed
+    }
+    std::error_code error;
+    std::filesystem::create_directories(archiveDirectory, error);
+    if (error) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not create archive directory " << archiveDirectory << ": " << error.message() << std::endl;
+        return false;
+    }
+
+    // Segments that receive more records must be in memory, or loading them later would duplicate the new records
+    int day, month, year;
+    civilFromDays(beforeDay, day, month, year);
+    const Appointment boundary(day, month, year, 0, 0, -1);
+    auto pending = firstActive();
+    while (pending != appointments.cend() && Appointment::earlier(*pending, boundary)) {
+        pending->date(day, month, year);
+        long monthStart = daysFromCivil(1, month, year);
+        long nextMonth = monthStart + daysInMonth(month, year);
+        loadArchivedRange(monthStart, nextMonth - 1); // May reallocate appointments
+        civilFromDays(nextMonth, day, month, year);
+        pending = std::lower_bound(firstActive(), appointments.cend(), Appointment(day, month, year, 0, 0, -1), Appointment::earlier);
+    }
+
+    auto first = firstActive();
+    auto last = std::lower_bound(first, appointments.cend(), boundary, Appointment::earlier);
+    for (auto it = first; it != last; ) {
+        // One monthly segment per run of appointments in the same month
+        it->date(day, month, year);
+        const Appointment nextMonth(1, month % 12 + 1, month == 12 ? year + 1 : year, 0, 0, -1);
+        auto monthEnd = it;
+        std::ostringstream records;
+        while (monthEnd != last && Appointment::earlier(*monthEnd, nextMonth)) {
+            writeRecord(records, *monthEnd);
+            ++monthEnd;
+        }
+        std::ostringstream name;
+        name << std::setfill('0') << std::setw(4) << year << "-" << std::setw(2) << month;
+        const std::string segmentFilename = archiveDirectory + "/" + name.str() + ".txt";
+
+        auto segment = std::find_if(archive.segments.begin(), archive.segments.end(), [&name](const ArchiveSegment& s) { return s.name == name.str(); });
+        std::string content;
+        if (segment != archive.segments.end()) {
+            std::ifstream previous(segmentFilename, std::ios::binary);
+            std::ostringstream previousContent;
+            previousContent << previous.rdbuf();
+            // The manifest is the commit point: records left by an interrupted run are dropped, not appended twice
+            content = committedRecords(previousContent.str(), segment->records);
+        } else { // A file left by an interrupted run without a manifest entry is overwritten
+            ArchiveSegment created;
+            created.name = name.str();
+            created.firstDay = it->dayNumber();
+            created.loaded = true;
+            archive.segments.push_back(created);
+            segment = archive.segments.end() - 1;
+        }
+        content += records.str();
+        if (!replaceFile(segmentFilename, content)) {
+            std::cerr << RED << BOLD << "Error: " << RESET << "Could not write archived segment: " << segmentFilename << std::endl;
+            return false;
+        }
+        segment->lastDay = (monthEnd - 1)->dayNumber();
+        segment->records += static_cast<size_t>(monthEnd - it);
+        archived += static_cast<size_t>(monthEnd - it);
+        it = monthEnd;
+    }
+
+    // The manifest moves the boundary; until the checkpoint below, the loader drops the duplicates left in the active file
+    archive.sealedBefore = beforeDay;
+    std::sort(archive.segments.begin(), archive.segments.end(), [](const ArchiveSegment& a, const ArchiveSegment& b) {
+        return a.firstDay < b.firstDay;
+    });
+    if (!saveArchiveManifest()) {
+        return false;
+    }
+    return checkpointAppointments(filename);
+}
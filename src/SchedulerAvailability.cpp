@@ -0,0 +1,119 @@
+#include "Scheduler.h"
+#include "Calendar.h"
+#include "Instrumentation.h"
+#include <iostream>     // For std::endl
+#include <iomanip>      // For std::setw, std::setprecision
+#include <sstream>      // For std::ostringstream
+#include <algorithm>    // For std::max
+#include <climits>      // For LONG_MIN
+
+// ANSI Color codes
+const std::string RESET = "\033[0m";
+const std::string RED = "\033[31m";
+const std::string GREEN = "\033[32m";
+const std::string YELLOW = "\033[33m";
+const std::string BLUE = "\033[34m";
+const std::string MAGENTA = "\033[35m";
+const std::string CYAN = "\033[36m";
+const std::string WHITE = "\033[37m";
+const std::string BOLD = "\033[1m";
+
+const std::string AVAILABILITY_RULE = "---------------------------------------------------------------------------";
+
+// Share of free time above which a day is shown green, and below which it is shown red
+const double AVAILABILITY_HIGH = 50.0;
+const double AVAILABILITY_LOW = 20.0;
+
+/**
+ * @brief Formats a day number as "Mon dd/mm/yyyy".
+ */
+static std::string formatWeekday(long dayNumber) {
+    static const char* const WEEKDAYS[] = {"Thu", "Fri", "Sat", "Sun", "Mon", "Tue", "Wed"}; // Day 0 is 1/1/1970, a Thursday
+    int day, month, year;
+    civilFromDays(dayNumber, day, month, year);
+    std::ostringstream text;
+    text << WEEKDAYS[((dayNumber % 7) + 7) % 7] << " " << std::setfill('0') << std::setw(2) << day << "/" << std::setw(2) << month
+         << "/" << std::setw(4) << year;
+    return text.str();
+}
+
+/**
+ * @brief Displays the free capacity of every day of a range from the day index.
+ *
+ * Each day costs one popcount and one run scan over the 23 words of each resource's bitmap; a day
+ * without an entry in the index has no bookings and is entirely free, so nothing is rebuilt from
+ * the appointment list. Days sealed by an archive run can no longer be booked, so they are marked as
+ * archived and left out of the totals.
+ */
+bool Scheduler::displayAvailabilityMap(long fromDay, long toDay, int minGap, std::ostream& out) const {
+    ScopedTimer timer(Phase::Availability);
+    if (toDay < fromDay || minGap <= 0 || minGap > DayOccupancy::MINUTES_PER_DAY) {
+        out << RED << BOLD << "Error: " << RESET << "The range must not end before it starts and the gap must be 1-"
+            << DayOccupancy::MINUTES_PER_DAY << " minutes." << std::endl;
+        return false;
+    }
+    const DayOccupancy emptyDay;
+    const int emptyMinutes = emptyDay.freeMinutes();
+    int emptySlots = 0;
+    emptyDay.longestFreeRun(minGap, emptySlots);
+    const long long capacityPerDay = static_cast<long long>(resources.size()) * DayOccupancy::MINUTES_PER_DAY;
+
+    std::ostringstream rows;
+    long long totalFree = 0;
+    long long totalSlots = 0;
+    long fullDays = 0;
+    long archivedDays = 0;
+    for (long dayNumber = fromDay; dayNumber <= toDay; ++dayNumber) {
+        if (archive.sealedBefore != LONG_MIN && dayNumber < archive.sealedBefore) {
+            rows << std::left << WHITE << std::setw(20) << formatWeekday(dayNumber) << YELLOW << "(archived)" << RESET << '\n';
+            ++archivedDays;
+            continue;
+        }
+        long long freeMinutes = 0;
+        long long slots = 0;
+        int longest = 0;
+        for (size_t r = 0; r < resources.size(); ++r) {
+            const DayOccupancy* busy = occupancy(static_cast<int>(r), dayNumber);
+            if (!busy) {
+                freeMinutes += emptyMinutes;
+                slots += emptySlots;
+                longest = DayOccupancy::MINUTES_PER_DAY;
+                continue;
+            }
+            int fitting = 0;
+            freeMinutes += busy->freeMinutes();
+            longest = std::max(longest, busy->longestFreeRun(minGap, fitting));
+            slots += fitting;
+        }
+        const double percent = 100.0 * freeMinutes / capacityPerDay;
+        const std::string& heat = percent >= AVAILABILITY_HIGH ? GREEN : percent >= AVAILABILITY_LOW ? YELLOW : RED;
+        rows << std::left << WHITE << std::setw(20) << formatWeekday(dayNumber)
+             << heat << std::setw(13) << freeMinutes << std::fixed << std::setprecision(1) << std::setw(10) << percent
+             << std::setw(17) << longest << slots << (longest < minGap ? "  (full)" : "") << RESET << '\n';
+        totalFree += freeMinutes;
+        totalSlots += slots;
+        fullDays += longest < minGap ? 1 : 0;
+    }
+
+    const long rangeDays = toDay - fromDay + 1;
+    const long activeDays = rangeDays - archivedDays;
+    out << CYAN << BOLD << "\nAvailability " << formatWeekday(fromDay).substr(4) << " - " << formatWeekday(toDay).substr(4)
+        << " (slots of " << minGap << " min):" << RESET << '\n';
+    out << BLUE << AVAILABILITY_RULE << RESET << '\n';
+    out << std::left << MAGENTA << BOLD << std::setw(20) << "Day" << std::setw(13) << "Free (min)" << std::setw(10) << "Free %"
+        << std::setw(17) << "Longest (min)" << "Slots" << RESET << '\n';
+    out << BLUE << AVAILABILITY_RULE << RESET << '\n';
+    out << rows.str();
+    out << BLUE << AVAILABILITY_RULE << RESET << '\n';
+    out << std::left << WHITE << std::setw(20) << "Total" << GREEN << std::setw(13) << totalFree << std::fixed << std::setprecision(1)
+        << std::setw(10) << (activeDays > 0 ? 100.0 * totalFree / (static_cast<double>(capacityPerDay) * activeDays) : 0.0)
+        << std::setw(17) << "-" << totalSlots << RESET << '\n';
+    out << WHITE << fullDays << " of " << activeDays << " days have no free run of " << minGap << " minutes.";
+    if (archivedDays > 0) {
+        out << " " << archivedDays << " archived days are not counted.";
+    }
+    out << RESET << '\n';
+    out << BLUE << AVAILABILITY_RULE << RESET << "\n" << std::endl;
+    Instrumentation::add(Counter::RowsDisplayed, static_cast<uint64_t>(rangeDays));
+    return true;
+}
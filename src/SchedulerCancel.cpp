@@ -0,0 +1,179 @@
+#include "Scheduler.h"
+#include "Calendar.h"
+#include "Instrumentation.h"
+#include <iostream>     // For std::endl
+#include <iomanip>      // For std::setw, std::setfill
+#include <algorithm>    // For std::equal_range, std::upper_bound, std::rotate
+#include <climits>      // For LONG_MIN
+
+// ANSI Color codes
+const std::string RESET = "\033[0m";
+const std::string RED = "\033[31m";
+const std::string GREEN = "\033[32m";
+const std::string BOLD = "\033[1m";
+
+/**
+ * @brief Prints a date and time as dd/mm/yyyy hh:mm.
+ */
+static void printWhen(std::ostream& out, int day, int month, int year, int hour, int minute) {
+    out << std::setfill('0') << std::setw(2) << day << "/" << std::setw(2) << month << "/" << year
+        << " " << std::setw(2) << hour << ":" << std::setw(2) << minute << std::setfill(' ');
+}
+
+/**
+ * @brief Prints the start of an appointment as dd/mm/yyyy hh:mm.
+ */
+static void printWhen(std::ostream& out, const Appointment& app) {
+    int day, month, year;
+    app.date(day, month, year);
+    printWhen(out, day, month, year, app.hour(), app.minute());
+}
+
+/**
+ * @brief Finds the appointment that starts at a date and time by binary search; resourceId picks one when several start then.
+ */
+bool Scheduler::locateAppointment(int day, int month, int year, int hour, int minute, int resourceId,
+                                  std::vector<Appointment>::iterator& found, std::ostream& err) {
+    if (!isValidDate(day, month, year) || hour < 0 || hour > 23 || minute < 0 || minute > 59) {
+        err << RED << BOLD << "Error: " << RESET << "Invalid date or time of the appointment." << std::endl;
+        return false;
+    }
+    if (archive.sealedBefore != LONG_MIN && daysFromCivil(day, month, year) < archive.sealedBefore) {
+        err << RED << BOLD << "Error: " << RESET << "Appointments before the archived boundary cannot be changed." << std::endl;
+        return false;
+    }
+    auto range = std::equal_range(appointments.begin(), appointments.end(), Appointment(day, month, year, hour, minute, -1), Appointment::earlier);
+    found = appointments.end();
+    size_t matches = 0;
+    for (auto it = range.first; it != range.second; ++it) {
+        if (resourceId >= 0 && it->resourceId != resourceId) continue;
+        if (matches++ == 0) found = it;
+    }
+    if (matches == 0) {
+        err << RED << BOLD << "Error: " << RESET << "No appointment starts on ";
+        printWhen(err, day, month, year, hour, minute);
+        if (resourceId >= 0) err << " with " << resources[resourceId].name;
+        err << "." << std::endl;
+        return false;
+    }
+    if (matches > 1) {
+        err << RED << BOLD << "Error: " << RESET << matches << " appointments start on ";
+        printWhen(err, day, month, year, hour, minute);
+        err << "; name the chair or dentist (";
+        for (auto it = range.first; it != range.second; ++it) {
+            err << (it == range.first ? "" : ", ") << resources[it->resourceId].name;
+        }
+        err << ")." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Frees the minutes of an appointment and removes it from the stats; the appointment stays in the list.
+ */
+void Scheduler::unindexAppointment(std::vector<Appointment>::const_iterator app) {
+    if (app->resourceId < 0 || static_cast<size_t>(app->resourceId) >= dayIndex.size()) return;
+    const long dayNumber = app->dayNumber();
+    DayOccupancy& busy = dayIndex[app->resourceId][dayNumber];
+    busy.unmark(app->minuteOfDay(), app->duration);
+    stats.add(dayNumber, app->operationId, app->resourceId, app->duration, -1);
+
+    // The bitmap does not count overlaps, so the other bookings of that day and resource are marked again
+    Appointment dayStart;
+    dayStart.start = app->start - app->minuteOfDay();
+    auto first = std::lower_bound(appointments.cbegin(), appointments.cend(), dayStart, Appointment::earlier);
+    for (auto it = first; it != appointments.cend() && it->dayNumber() == dayNumber; ++it) {
+        if (it != app && it->resourceId == app->resourceId) {
+            busy.mark(it->minuteOfDay(), it->duration);
+        }
+    }
+}
+
+/**
+ * @brief Cancels the appointment that starts at a date and time.
+ *
+ * Finding the appointment and updating the day index and stats cost O(log n), but erasing it from the
+ * sorted vector shifts every later appointment, so a cancel is O(n) overall (one memmove of 16-byte records).
+ */
+bool Scheduler::cancelAppointment(int day, int month, int year, int hour, int minute, int resourceId, Appointment* cancelled,
+                                  std::ostream& out, std::ostream& err) {
+    ScopedTimer timer(Phase::Schedule);
+    std::vector<Appointment>::iterator found;
+    if (!locateAppointment(day, month, year, hour, minute, resourceId, found, err)) {
+        return false;
+    }
+    const Appointment app = *found;
+    unindexAppointment(found);
+    appointments.erase(found);
+    if (cancelled) {
+        *cancelled = app;
+    }
+
+    out << GREEN << BOLD << "Appointment cancelled: '" << operationOf(app).name << "' on ";
+    printWhen(out, app);
+    if (resources.size() > 1) {
+        out << " with " << resources[app.resourceId].name;
+    }
+    out << "." << RESET << std::endl;
+    return true;
+}
+
+/**
+ * @brief Moves an appointment to a new date and time; only the appointments between the old and new position are shifted.
+ *
+ * The lookup is a binary search, but the rotate is O(k) in the number of appointments between the two
+ * dates, so moving an appointment far in time on a large history approaches O(n), like a cancel.
+ */
+bool Scheduler::rescheduleAppointment(int day, int month, int year, int hour, int minute, int newDay, int newMonth, int newYear, int newHour, int newMinute,
+                                      int resourceId, Appointment* previous, Appointment* moved, std::ostream& out, std::ostream& err) {
+    ScopedTimer timer(Phase::Schedule);
+    std::vector<Appointment>::iterator found;
+    if (!locateAppointment(day, month, year, hour, minute, resourceId, found, err)) {
+        return false;
+    }
+    const Appointment old = *found;
+
+    // The appointment's own minutes are free while the new slot is checked, so it can move by less than its duration
+    unindexAppointment(found);
+    int newResource = 0;
+    BookingStatus status = checkBooking(BookingRequest{newDay, newMonth, newYear, newHour, newMinute, old.operationId + 1}, &newResource);
+    if (status != BookingStatus::Accepted) {
+        indexAppointment(old);
+        err << RED << BOLD << "Error: " << RESET << "Cannot move '" << operationOf(old).name << "' to ";
+        printWhen(err, newDay, newMonth, newYear, newHour, newMinute);
+        err << ": " << describeBookingStatus(status) << "." << std::endl;
+        return false;
+    }
+    const DayOccupancy* sameChair = occupancy(old.resourceId, newDay, newMonth, newYear);
+    if (resources[old.resourceId].supports(old.operationId) && (!sameChair || sameChair->isFree(newHour * 60 + newMinute, old.duration))) {
+        newResource = old.resourceId; // Keep the patient with the same chair or dentist when possible
+    }
+
+    const Appointment app(newDay, newMonth, newYear, newHour, newMinute, old.operationId, newResource, old.duration);
+    auto pos = std::upper_bound(appointments.begin(), appointments.end(), app, Appointment::earlier);
+    if (pos > found) {
+        std::rotate(found, found + 1, pos);
+        *(pos - 1) = app;
+    } else {
+        std::rotate(pos, found, found + 1);
+        *pos = app;
+    }
+    indexAppointment(app);
+    if (previous) {
+        *previous = old;
+    }
+    if (moved) {
+        *moved = app;
+    }
+
+    out << GREEN << BOLD << "Appointment moved: '" << operationOf(app).name << "' from ";
+    printWhen(out, old);
+    out << " to ";
+    printWhen(out, app);
+    if (resources.size() > 1) {
+        out << " with " << resources[app.resourceId].name;
+    }
+    out << "." << RESET << std::endl;
+    return true;
+}
@@ -0,0 +1,80 @@
+#include "Scheduler.h"
+#include "JournalTransaction.h"
+#include "FileLock.h"
+#include "Instrumentation.h"
+#include <iostream>     // For std::cerr, std::endl
+#include <sys/stat.h>   // For stat
+
+// ANSI Color codes
+const std::string RESET = "\033[0m";
+const std::string YELLOW = "\033[33m";
+const std::string BOLD = "\033[1m";
+
+/**
+ * @brief Returns the lock file that serializes writers of an appointments file; it also holds the checkpoint generation.
+ */
+std::string Scheduler::lockFileName(const std::string& filename) {
+    return filename + ".lock";
+}
+
+/**
+ * @brief Brings in the records that other processes appended since the load; callers hold the journal lock.
+ */
+bool Scheduler::refreshAppointments(const std::string& filename) {
+    ScopedTimer timer(Phase::CatchUp);
+    if (readCounterFile(lockFileName(filename)) != journalGeneration) {
+        // A checkpoint or an archive run rewrote the snapshot and removed the journal: start over from the new files
+        appointments.clear();
+        return loadAppointments(filename);
+    }
+    size_t before = journalRecords;
+    replayJournal(filename, true);
+    Instrumentation::add(Counter::RecordsCaughtUp, journalRecords - before);
+    return true;
+}
+
+/**
+ * @brief Tells, from the journal size and the checkpoint generation, whether a refresh would find anything new.
+ */
+bool Scheduler::hasExternalChanges(const std::string& filename) const {
+    if (readCounterFile(lockFileName(filename)) != journalGeneration) {
+        return true;
+    }
+    struct stat st;
+    size_t size = stat(journalFileName(filename).c_str(), &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+    return size != journalOffset;
+}
+
+/**
+ * @brief Takes the journal lock and catches the scheduler up with the other writers.
+ */
+JournalTransaction::JournalTransaction(Scheduler& scheduler, const std::string& filename)
+    : scheduler(scheduler), journalFilename(Scheduler::journalFileName(filename)), lock(Scheduler::lockFileName(filename)),
+      startOffset(0), endOffset(0), released(false) {
+    if (!lock.locked()) {
+        std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Could not lock " << Scheduler::lockFileName(filename)
+                  << "; changes made by other processes may be missed." << std::endl;
+    }
+    scheduler.refreshAppointments(filename);
+    startOffset = scheduler.journalOffset;
+}
+
+/**
+ * @brief Releases the journal lock and makes what this transaction appended durable.
+ */
+JournalTransaction::~JournalTransaction() {
+    release();
+    if (endOffset > startOffset) { // Nothing to sync after a rejected request or a checkpoint
+        groupCommit(journalFilename, endOffset);
+    }
+}
+
+/**
+ * @brief Releases the journal lock; the group commit waits for the destructor.
+ */
+void JournalTransaction::release() {
+    if (released) return;
+    endOffset = scheduler.journalOffset;
+    released = true;
+    lock.release();
+}
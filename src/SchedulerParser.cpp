@@ -0,0 +1,163 @@
+#include "Scheduler.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include "TextFields.h"
+#include "Calendar.h"
+#include "Instrumentation.h"
+#include <algorithm>    // For std::sort, std::inplace_merge
+#include <iostream>     // For std::cerr, std::endl
+#include <thread>       // For std::thread::hardware_concurrency
+
+// ANSI Color codes
+const std::string RESET = "\033[0m";
+const std::string YELLOW = "\033[33m";
+const std::string BOLD = "\033[1m";
+
+// Files smaller than this are parsed as a single chunk
+const size_t MIN_CHUNK_BYTES = 256 * 1024;
+
+// A problem found on one line of a chunk; the line is relative to the chunk start
+struct ParseIssue {
+    size_t line;
+    std::string message;
+};
+
+// Records and issues produced by one chunk
+struct ParsedChunk {
+    std::vector<Appointment> records;
+    std::vector<Appointment> cancelled; // Targets of CANCEL tombstones
+    std::vector<ParseIssue> issues;
+    size_t lines = 0;
+};
+
+/**
+ * @brief Splits a buffer into roughly equal chunks that end on line boundaries.
+ */
+static std::vector<size_t> chunkBoundaries(const char* data, size_t size) {
+    size_t chunks = std::max<size_t>(1, std::min<size_t>(size / MIN_CHUNK_BYTES, 4 * std::max(1u, std::thread::hardware_concurrency())));
+    std::vector<size_t> bounds(1, 0);
+    for (size_t i = 1; i < chunks; ++i) {
+        size_t pos = std::max(bounds.back(), size * i / chunks);
+        while (pos < size && data[pos - 1] != '\n') ++pos;
+        if (pos < size) bounds.push_back(pos);
+    }
+    bounds.push_back(size);
+    return bounds;
+}
+
+/**
+ * @brief Merges consecutive sorted runs of a vector pairwise until it is fully sorted.
+ */
+static void mergeSortedRuns(std::vector<Appointment>& records, std::vector<size_t> runs) {
+    while (runs.size() > 2) {
+        std::vector<size_t> merged(1, 0);
+        for (size_t i = 0; i + 2 < runs.size(); i += 2) {
+            std::inplace_merge(records.begin() + runs[i], records.begin() + runs[i + 1], records.begin() + runs[i + 2], Appointment::earlier);
+            merged.push_back(runs[i + 2]);
+        }
+        if (runs.size() % 2 == 0) merged.push_back(runs.back()); // Odd run count: the last run waits for the next round
+        runs.swap(merged);
+    }
+}
+
+/**
+ * @brief Reads appointment records from a snapshot or journal file; the records are appended to out in sorted order.
+ * Journal tombstones ("CANCEL <record>") go to cancelled when it is given and are rejected otherwise.
+ * With offset, reading starts at *offset and stops after the last complete line, whose end is stored back:
+ * a line that another process is still appending is left for the next read. With line, *line holds the number
+ * of lines before *offset, so warnings are numbered from the top of the file, and it is advanced past the lines read.
+ */
+bool Scheduler::readAppointmentRecords(const std::string& filename, std::vector<Appointment>& out, std::vector<Appointment>* cancelled,
+                                       size_t* offset, size_t* line) const {
+    ScopedTimer timer(Phase::ParseRecords);
+    MappedFile file;
+    if (!file.open(filename)) {
+        return false;
+    }
+    const char* data = file.data();
+    size_t size = file.size();
+    if (offset) {
+        size_t start = std::min(*offset, size);
+        while (size > start && data[size - 1] != '\n') --size;
+        data += start;
+        size -= start;
+        *offset = start + size;
+    }
+    Instrumentation::add(Counter::BytesRead, size);
+    std::vector<size_t> bounds = chunkBoundaries(data, size);
+    std::vector<ParsedChunk> chunks(bounds.size() - 1);
+
+    parallelFor(chunks.size(), [&](size_t c) {
+        ParsedChunk& chunk = chunks[c];
+        const char* pos = data + bounds[c];
+        const char* end = data + bounds[c + 1];
+        while (pos < end) {
+            const char* lineEnd = std::find(pos, end, '\n');
+            ++chunk.lines;
+            std::string_view first = nextField(pos, lineEnd);
+            if (first.empty()) { // Blank line
+                pos = lineEnd + 1;
+                continue;
+            }
+            // Format: [CANCEL] <day> <month> <year> <hour> <minute> <operation_name> [resource_name] [cite: 5]
+            const bool tombstone = first == "CANCEL";
+            if (tombstone) {
+                first = nextField(pos, lineEnd);
+            }
+            int fields[5];
+            bool valid = parseField(first, fields[0]);
+            for (int i = 1; i < 5; ++i) {
+                valid = valid && parseField(nextField(pos, lineEnd), fields[i]);
+            }
+            std::string_view opName = nextField(pos, lineEnd);
+            std::string_view resourceName = nextField(pos, lineEnd); // Missing in files written before resources existed
+            if (!valid || opName.empty() || !nextField(pos, lineEnd).empty() || (tombstone && !cancelled)) {
+                chunk.issues.push_back(ParseIssue{chunk.lines, "malformed record skipped."});
+            } else if (!isValidDate(fields[0], fields[1], fields[2]) || fields[3] < 0 || fields[3] > 23 || fields[4] < 0 || fields[4] > 59) {
+                chunk.issues.push_back(ParseIssue{chunk.lines, "invalid date or time. Appointment skipped."});
+            } else {
+                int opId = findOperationId(std::string(opName));
+                int resId = resourceName.empty() ? 0 : findResourceId(std::string(resourceName));
+                if (opId < 0) {
+                    chunk.issues.push_back(ParseIssue{chunk.lines, "operation '" + std::string(opName) + "' was not found. Appointment skipped."});
+                } else if (resId < 0) {
+                    chunk.issues.push_back(ParseIssue{chunk.lines, "resource '" + std::string(resourceName) + "' was not found. Appointment skipped."});
+                } else {
+                    (tombstone ? chunk.cancelled : chunk.records).emplace_back(fields[0], fields[1], fields[2], fields[3], fields[4], opId, resId,
+                                                                               operations[opId].duration);
+                }
+            }
+            pos = lineEnd + 1;
+        }
+        std::sort(chunk.records.begin(), chunk.records.end(), Appointment::earlier);
+    });
+
+    size_t firstLine = line ? *line : 0;
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        for (const auto& issue : chunk.issues) {
+            std::cerr << YELLOW << BOLD << "Warning: " << RESET << filename << " line " << firstLine + issue.line << ": " << issue.message << std::endl;
+        }
+        firstLine += chunk.lines;
+        total += chunk.records.size();
+        if (cancelled) {
+            cancelled->insert(cancelled->end(), chunk.cancelled.begin(), chunk.cancelled.end());
+        }
+        Instrumentation::add(Counter::RecordsSkipped, chunk.issues.size());
+    }
+
+    if (line) {
+        *line = firstLine;
+    }
+
+    std::vector<size_t> runs(1, 0);
+    if (!out.empty()) runs.push_back(out.size()); // Whatever out held before is one more sorted run
+    Instrumentation::add(Counter::RecordsParsed, total);
+    out.reserve(out.size() + total);
+    for (auto& chunk : chunks) {
+        out.insert(out.end(), chunk.records.begin(), chunk.records.end());
+        runs.push_back(out.size());
+    }
+    mergeSortedRuns(out, runs);
+    return true;
+}
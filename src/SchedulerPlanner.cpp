@@ -0,0 +1,163 @@
+#include "Scheduler.h"
+#include "Calendar.h"
+#include "ParallelFor.h"
+#include "TextFields.h"
+#include "Instrumentation.h"
+#include <algorithm>    // For std::sort, std::inplace_merge, std::max, std::min
+#include <climits>      // For LONG_MIN
+#include <unordered_map>
+
+// A waiting-list request that passed validation, with its catalog entry resolved
+struct PlanItem {
+    size_t index;           // Position in the queue
+    int operationId;
+    int duration;
+    long earliestDay, latestDay;
+    int fromMinute, toMinute;
+};
+
+/**
+ * @brief Plans a waiting list with an earliest-deadline-first greedy over the day index.
+ *
+ * Requests that could take the same chair on the same day form one group; the groups touch disjoint
+ * chair-days, so they are planned in parallel, each on a private copy of the occupancy of its days. A group
+ * is planned in one pass because placing a request changes what is left for every request whose window
+ * overlaps it, so rolling windows on a shared chair chain into one group. Inside a group the requests are taken
+ * by latest date, then shortest (Requests) or longest (Minutes) operation first, and each one gets the
+ * earliest start that fits its preferred hours on a compatible chair.
+ */
+std::vector<BookingStatus> Scheduler::planRequests(const std::vector<PlanRequest>& queue, PlanObjective objective, std::vector<Appointment>* planned) {
+    ScopedTimer timer(Phase::Plan);
+    std::vector<BookingStatus> results(queue.size(), BookingStatus::SlotTaken);
+    std::vector<Appointment> assigned(queue.size());
+    std::vector<PlanItem> items;
+    items.reserve(queue.size());
+
+    const long firstBookable = std::max(daysFromCivil(1, 1, FIRST_BOOKABLE_YEAR), archive.sealedBefore);
+    const long lastBookable = daysFromCivil(31, 12, LAST_BOOKABLE_YEAR);
+    for (size_t i = 0; i < queue.size(); ++i) {
+        const PlanRequest& request = queue[i];
+        int operationId = findOperationId(request.operation);
+        int number;
+        if (operationId < 0 && parseField(request.operation, number) && number >= 1 && static_cast<size_t>(number) <= operations.size()) {
+            operationId = number - 1; // Operation number as shown by view_operations
+        }
+        if (operationId < 0) {
+            results[i] = BookingStatus::InvalidOperation;
+            continue;
+        }
+        bool compatible = false;
+        for (const auto& resource : resources) {
+            compatible = compatible || resource.supports(operationId);
+        }
+        if (!compatible) {
+            results[i] = BookingStatus::NoResource;
+            continue;
+        }
+        PlanItem item = {i, operationId, operations[operationId].duration, std::max(request.earliestDay, firstBookable),
+                         std::min(request.latestDay, lastBookable), request.fromMinute, request.toMinute};
+        if (item.earliestDay > item.latestDay) {
+            bool sealed = archive.sealedBefore != LONG_MIN && request.latestDay < archive.sealedBefore;
+            results[i] = sealed ? BookingStatus::Archived : BookingStatus::InvalidDateTime;
+            continue;
+        }
+        if (item.fromMinute + item.duration > 24 * 60) {
+            results[i] = BookingStatus::PastMidnight;
+            continue;
+        }
+        items.push_back(item);
+    }
+
+    // Split the requests into groups that compete for a chair: two requests are linked when their date windows
+    // overlap and some chair can perform both; a chain of such links is one group
+    std::vector<size_t> parent(items.size());
+    for (size_t i = 0; i < items.size(); ++i) parent[i] = i;
+    auto root = [&parent](size_t i) {
+        while (parent[i] != i) i = parent[i] = parent[parent[i]];
+        return i;
+    };
+    std::vector<size_t> byStart(items.size());
+    for (size_t i = 0; i < items.size(); ++i) byStart[i] = i;
+    std::sort(byStart.begin(), byStart.end(), [&items](size_t a, size_t b) { return items[a].earliestDay < items[b].earliestDay; });
+    for (const auto& resource : resources) {
+        size_t head = 0;
+        long groupEnd = LONG_MIN;
+        for (size_t i : byStart) {
+            if (!resource.supports(items[i].operationId)) continue;
+            if (items[i].earliestDay <= groupEnd) {
+                parent[root(i)] = root(head);
+            } else {
+                head = i;
+            }
+            groupEnd = std::max(groupEnd, items[i].latestDay);
+        }
+    }
+    std::vector<std::vector<PlanItem>> groups;
+    std::unordered_map<size_t, size_t> groupOf;
+    for (size_t i : byStart) {
+        auto found = groupOf.emplace(root(i), groups.size());
+        if (found.second) groups.emplace_back();
+        groups[found.first->second].push_back(items[i]);
+    }
+
+    parallelFor(groups.size(), [&](size_t g) {
+        auto first = groups[g].begin();
+        auto last = groups[g].end();
+        std::sort(first, last, [objective](const PlanItem& a, const PlanItem& b) {
+            if (a.latestDay != b.latestDay) return a.latestDay < b.latestDay;
+            if (a.duration != b.duration) return objective == PlanObjective::Requests ? a.duration < b.duration : a.duration > b.duration;
+            if (a.latestDay - a.earliestDay != b.latestDay - b.earliestDay) return a.latestDay - a.earliestDay < b.latestDay - b.earliestDay;
+            return a.index < b.index;
+        });
+
+        // Private occupancy of the group's days; the shared day index is only read, and a day shared with another
+        // group is only marked on chairs that group cannot use
+        std::unordered_map<long, std::vector<DayOccupancy>> days;
+        for (auto item = first; item != last; ++item) {
+            for (long dayNumber = item->earliestDay; dayNumber <= item->latestDay; ++dayNumber) {
+                int day, month, year;
+                civilFromDays(dayNumber, day, month, year);
+                auto cached = days.find(dayNumber);
+                if (cached == days.end()) {
+                    cached = days.emplace(dayNumber, std::vector<DayOccupancy>(resources.size())).first;
+                    for (size_t r = 0; r < resources.size(); ++r) {
+                        const DayOccupancy* busy = occupancy(static_cast<int>(r), day, month, year);
+                        if (busy) cached->second[r] = *busy;
+                    }
+                }
+                std::vector<DayOccupancy>& busy = cached->second;
+                int start = -1;
+                int resourceId = -1;
+                for (size_t r = 0; r < resources.size(); ++r) {
+                    if (!resources[r].supports(item->operationId)) continue;
+                    int candidate = busy[r].findFreeRun(item->fromMinute, item->duration);
+                    if (candidate >= 0 && candidate + item->duration <= item->toMinute && (start < 0 || candidate < start)) {
+                        start = candidate;
+                        resourceId = static_cast<int>(r);
+                    }
+                }
+                if (start < 0) continue;
+                busy[resourceId].mark(start, item->duration);
+                assigned[item->index] = Appointment(day, month, year, start / 60, start % 60, item->operationId, resourceId, item->duration);
+                results[item->index] = BookingStatus::Accepted;
+                break;
+            }
+        }
+    });
+
+    std::vector<Appointment> accepted;
+    for (size_t i = 0; i < queue.size(); ++i) {
+        if (results[i] == BookingStatus::Accepted) accepted.push_back(assigned[i]);
+    }
+    std::sort(accepted.begin(), accepted.end(), Appointment::earlier);
+    for (const auto& app : accepted) {
+        indexAppointment(app);
+    }
+    size_t existing = appointments.size();
+    appointments.insert(appointments.end(), accepted.begin(), accepted.end());
+    std::inplace_merge(appointments.begin(), appointments.begin() + existing, appointments.end(), Appointment::earlier);
+    if (planned) {
+        *planned = std::move(assigned);
+    }
+    return results;
+}
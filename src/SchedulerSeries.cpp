@@ -0,0 +1,169 @@
+#include "Scheduler.h"
+#include "Calendar.h"
+#include "Instrumentation.h"
+#include <iostream>     // For std::endl
+#include <iomanip>      // For std::setw, std::setfill
+#include <algorithm>    // For std::sort, std::inplace_merge
+#include <cstdlib>      // For std::abs
+
+// ANSI Color codes
+const std::string RESET = "\033[0m";
+const std::string RED = "\033[31m";
+const std::string GREEN = "\033[32m";
+const std::string YELLOW = "\033[33m";
+const std::string CYAN = "\033[36m";
+const std::string BOLD = "\033[1m";
+
+// How many days before and after a conflicting occurrence are searched for an alternative
+const int SERIES_ALTERNATIVE_DAYS = 7;
+
+/**
+ * @brief Prints a request as dd/mm/yyyy hh:mm.
+ */
+static void printWhen(std::ostream& out, const BookingRequest& r) {
+    out << std::setfill('0') << std::setw(2) << r.day << "/" << std::setw(2) << r.month << "/" << r.year
+        << " " << std::setw(2) << r.hour << ":" << std::setw(2) << r.minute << std::setfill(' ');
+}
+
+/**
+ * @brief Checks every occurrence of a series against the day index in one pass and books them only if all are free.
+ */
+std::vector<BookingStatus> Scheduler::bookSeries(const std::vector<BookingRequest>& occurrences, std::vector<Appointment>* scheduled) {
+    ScopedTimer timer(Phase::Schedule);
+    std::vector<BookingStatus> results;
+    results.reserve(occurrences.size());
+    std::vector<Appointment> pending;
+    pending.reserve(occurrences.size());
+    bool allAccepted = true;
+    for (const auto& occurrence : occurrences) {
+        int resourceId = 0;
+        BookingStatus status = checkBooking(occurrence, &resourceId);
+        if (status == BookingStatus::Accepted) {
+            pending.emplace_back(occurrence.day, occurrence.month, occurrence.year, occurrence.hour, occurrence.minute,
+                                 occurrence.operation_number - 1, resourceId, operations[occurrence.operation_number - 1].duration);
+        }
+        allAccepted = allAccepted && status == BookingStatus::Accepted;
+        results.push_back(status);
+    }
+    if (!allAccepted || pending.empty()) {
+        return results; // All or nothing
+    }
+
+    std::sort(pending.begin(), pending.end(), Appointment::earlier);
+    for (const auto& app : pending) {
+        indexAppointment(app);
+    }
+    size_t existing = appointments.size();
+    appointments.insert(appointments.end(), pending.begin(), pending.end());
+    std::inplace_merge(appointments.begin(), appointments.begin() + existing, appointments.end(), Appointment::earlier);
+    if (scheduled) {
+        *scheduled = std::move(pending);
+    }
+    return results;
+}
+
+/**
+ * @brief Finds the free slot closest to a request: same day first, then up to maxDays before or after, nearest time of day.
+ */
+bool Scheduler::nearestFreeSlot(const BookingRequest& request, int maxDays, BookingRequest& alternative) const {
+    if (request.operation_number <= 0 || static_cast<size_t>(request.operation_number) > operations.size()) {
+        return false;
+    }
+    const int operationId = request.operation_number - 1;
+    const int duration = operations[operationId].duration;
+    const int wanted = request.hour * 60 + request.minute;
+    const long requestDay = daysFromCivil(request.day, request.month, request.year);
+    const DayOccupancy freeDay;
+    for (int offset = 0; offset <= maxDays; ++offset) {
+        int bestDistance = -1;
+        for (int direction = -1; direction <= 1; direction += 2) {
+            if (offset == 0 && direction < 0) continue;
+            BookingRequest candidate = request;
+            civilFromDays(requestDay + direction * offset, candidate.day, candidate.month, candidate.year);
+            for (size_t r = 0; r < resources.size(); ++r) {
+                if (!resources[r].supports(operationId)) continue;
+                const DayOccupancy* busy = occupancy(static_cast<int>(r), candidate.day, candidate.month, candidate.year);
+                if (!busy) busy = &freeDay;
+                const int starts[2] = {busy->findFreeRunBefore(wanted, duration), busy->findFreeRun(wanted, duration)};
+                for (int start : starts) {
+                    if (start < 0) continue;
+                    int distance = std::abs(start - wanted);
+                    if (bestDistance >= 0 && distance >= bestDistance) continue;
+                    candidate.hour = start / 60;
+                    candidate.minute = start % 60;
+                    if (checkBooking(candidate) != BookingStatus::Accepted) continue; // Outside the bookable years
+                    bestDistance = distance;
+                    alternative = candidate;
+                }
+            }
+        }
+        if (bestDistance >= 0) {
+            return true; // Any slot on a farther day is at least a whole day away
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Schedules a recurring series all-or-nothing and reports conflicts with their nearest alternatives.
+ */
+bool Scheduler::scheduleSeries(const BookingRequest& first, const RecurrenceRule& rule, std::vector<Appointment>* scheduled,
+                               std::ostream& out, std::ostream& err) {
+    if (first.operation_number <= 0 || static_cast<size_t>(first.operation_number) > operations.size()) {
+        err << RED << BOLD << "Error: " << RESET << "Invalid operation number." << std::endl;
+        displayOperations(out);
+        return false;
+    }
+    if (!isValidDate(first.day, first.month, first.year)) {
+        err << RED << BOLD << "Error: " << RESET << "Invalid date or time for appointment." << std::endl;
+        return false;
+    }
+    std::vector<BookingRequest> occurrences;
+    std::string error;
+    if (!expandRecurrence(first, rule, occurrences, error)) {
+        err << RED << BOLD << "Error: " << RESET << error << std::endl;
+        return false;
+    }
+    if (occurrences.empty()) {
+        err << RED << BOLD << "Error: " << RESET << "The series ends before its first appointment." << std::endl;
+        return false;
+    }
+
+    const Operation& selectedOp = operations[first.operation_number - 1];
+    std::vector<Appointment> booked;
+    std::vector<BookingStatus> results = bookSeries(occurrences, &booked);
+    if (!booked.empty()) {
+        out << GREEN << BOLD << "Series scheduled: " << booked.size() << " x '" << selectedOp.name << "' from ";
+        printWhen(out, occurrences.front());
+        out << " to ";
+        printWhen(out, occurrences.back());
+        out << "." << RESET << std::endl;
+        if (scheduled) {
+            *scheduled = std::move(booked);
+        }
+        return true;
+    }
+
+    size_t conflicts = 0;
+    for (BookingStatus status : results) {
+        if (status != BookingStatus::Accepted) ++conflicts;
+    }
+    out << RED << BOLD << "Series not scheduled: " << conflicts << " of " << occurrences.size() << " occurrences of '"
+        << selectedOp.name << "' (duration " << selectedOp.duration << " min) are not available." << RESET << std::endl;
+    for (size_t i = 0; i < occurrences.size(); ++i) {
+        if (results[i] == BookingStatus::Accepted) continue;
+        out << RED;
+        printWhen(out, occurrences[i]);
+        out << RESET << " (" << describeBookingStatus(results[i]) << ")";
+        BookingRequest alternative;
+        if (results[i] == BookingStatus::SlotTaken && nearestFreeSlot(occurrences[i], SERIES_ALTERNATIVE_DAYS, alternative)) {
+            out << CYAN << " nearest free: " << RESET;
+            printWhen(out, alternative);
+        } else if (results[i] == BookingStatus::SlotTaken) {
+            out << YELLOW << " no free slot within " << SERIES_ALTERNATIVE_DAYS << " days" << RESET;
+        }
+        out << '\n';
+    }
+    out << std::flush;
+    return false;
+}
@@ -0,0 +1,507 @@
+#include "SchedulerServer.h"
+#include "JournalTransaction.h"
+#include "Calendar.h"
+#include "TextFields.h"
+#include <iostream>     // For std::cout, std::cerr, std::endl
+#include <iomanip>      // For std::setw, std::setprecision
+#include <sstream>      // For std::ostringstream, std::istringstream
+#include <stdexcept>    // For std::invalid_argument, std::out_of_range
+#include <thread>       // For std::thread
+#include <condition_variable> // For std::condition_variable
+#include <deque>        // For std::deque
+#include <algorithm>    // For std::max, std::find
+#include <chrono>       // For std::chrono::steady_clock
+#include <atomic>       // For std::atomic
+#include <csignal>      // For std::signal
+#include <cstring>      // For strncpy
+#include <cstdio>       // For std::remove
+#include <cstdlib>      // For std::atoi
+
+#ifndef _WIN32
+#include <sys/socket.h> // For socket, bind, listen, accept
+#include <sys/un.h>     // For sockaddr_un
+#include <sys/time.h>   // For timeval
+#include <poll.h>       // For poll
+#include <unistd.h>     // For read, write, close
+#endif
+
+// ANSI Color codes
+const std::string RESET = "\033[0m";
+const std::string RED = "\033[31m";
+const std::string GREEN = "\033[32m";
+const std::string BLUE = "\033[34m";
+const std::string MAGENTA = "\033[35m";
+const std::string CYAN = "\033[36m";
+const std::string BOLD = "\033[1m";
+
+// Largest request line accepted from a client
+const size_t MAX_REQUEST_BYTES = 4096;
+// A client that sends nothing for this long is disconnected
+const int CLIENT_READ_TIMEOUT_SECONDS = 10;
+// Clients accepted but not yet picked up by a worker; past this the server answers that it is busy
+const size_t MAX_PENDING_CLIENTS = 256;
+
+// Commands the server recognises; only these get a row in the latency table
+static const char* const SERVER_COMMANDS[] = {"view_operations", "check_availability", "schedule", "schedule_series", "cancel",
+                                              "reschedule", "view_history", "stats", "availability_map", "save_and_exit",
+                                              "server_stats"};
+
+static std::atomic<bool> stopRequested(false);
+
+static void requestStop(int) {
+    stopRequested = true;
+}
+
+SchedulerServer::SchedulerServer(Scheduler& scheduler, const std::string& appsFilename, size_t checkpointRecords)
+    : scheduler(scheduler), appsFilename(appsFilename), checkpointRecords(checkpointRecords) {}
+
+/**
+ * @brief Runs one command against the resident scheduler, taking the lock the command needs.
+ */
+int SchedulerServer::execute(const std::vector<std::string>& args, std::ostream& out) {
+    if (args.empty()) {
+        out << RED << BOLD << "Error: " << RESET << "Empty command." << std::endl;
+        return 1;
+    }
+    const std::string& command = args[0];
+    try {
+        if (command == "view_operations" && args.size() == 1) {
+            std::shared_lock<std::shared_mutex> lock(schedulerMutex);
+            scheduler.displayOperations(out);
+        } else if (command == "view_history") {
+            HistoryQuery query;
+            std::string error;
+            if (!parseHistoryQuery(std::vector<std::string>(args.begin() + 1, args.end()), query, error)) {
+                out << RED << BOLD << "Error: " << RESET << error << std::endl;
+                return 1;
+            }
+            catchUp();
+            loadArchivedRange(query.fromDay, query.toDay);
+            std::shared_lock<std::shared_mutex> lock(schedulerMutex);
+            if (!scheduler.displayAppointmentHistory(query, out)) {
+                return 1;
+            }
+        } else if (command == "stats") {
+            StatsQuery query;
+            std::string error;
+            if (!parseStatsQuery(std::vector<std::string>(args.begin() + 1, args.end()), query, error)) {
+                out << RED << BOLD << "Error: " << RESET << error << std::endl;
+                return 1;
+            }
+            catchUp();
+            loadArchivedRange(query.fromDay, query.toDay);
+            std::shared_lock<std::shared_mutex> lock(schedulerMutex);
+            scheduler.displayStats(query, out);
+        } else if (command == "availability_map" && (args.size() == 3 || args.size() == 4)) {
+            int fromDay, fromMonth, fromYear, toDay, toMonth, toYear;
+            if (!parseDate(args[1], fromDay, fromMonth, fromYear) || !parseDate(args[2], toDay, toMonth, toYear)) {
+                out << RED << BOLD << "Error: " << RESET << "Dates must be valid and written as day/month/year." << std::endl;
+                return 1;
+            }
+            const long first = daysFromCivil(fromDay, fromMonth, fromYear);
+            const long last = daysFromCivil(toDay, toMonth, toYear);
+            int minGap = 30;
+            if (args.size() == 4 && !parseField(args[3], minGap)) {
+                minGap = 0; // Not a number: reported with the gap range below
+            }
+            catchUp();
+            std::shared_lock<std::shared_mutex> lock(schedulerMutex);
+            if (!scheduler.displayAvailabilityMap(first, last, minGap, out)) {
+                return 1;
+            }
+        } else if (command == "check_availability" && args.size() == 6) {
+            int day = std::stoi(args[1]);
+            int month = std::stoi(args[2]);
+            int year = std::stoi(args[3]);
+            int hour = std::stoi(args[4]);
+            int minute = std::stoi(args[5]);
+            catchUp();
+            std::shared_lock<std::shared_mutex> lock(schedulerMutex);
+            scheduler.reportMinuteAvailability(day, month, year, hour, minute, out);
+        } else if (command == "schedule" && args.size() == 7) {
+            int day = std::stoi(args[1]);
+            int month = std::stoi(args[2]);
+            int year = std::stoi(args[3]);
+            int hour = std::stoi(args[4]);
+            int minute = std::stoi(args[5]);
+            int op_num = std::stoi(args[6]);
+            std::unique_lock<std::shared_mutex> lock(schedulerMutex);
+            JournalTransaction transaction(scheduler, appsFilename); // Other processes may write the same files
+            Appointment scheduled;
+            if (!scheduler.scheduleAppointment(day, month, year, hour, minute, op_num, &scheduled, out, out)) {
+                return 0; // Same exit code as user_app for a rejected slot
+            }
+            if (!scheduler.appendAppointment(appsFilename, scheduled)) {
+                out << RED << BOLD << "CRITICAL WARNING: " << RESET << "Appointment was added to memory, but saving to file "
+                    << appsFilename << RED << " FAILED!" << RESET << std::endl;
+                return 2;
+            }
+            if (scheduler.journalSize() >= checkpointRecords) {
+                scheduler.checkpointAppointments(appsFilename);
+            }
+            // The fsync runs after both locks are released, so it is shared with the writers that follow
+            transaction.release();
+            lock.unlock();
+        } else if (command == "schedule_series" && args.size() == 9) {
+            BookingRequest first;
+            first.day = std::stoi(args[1]);
+            first.month = std::stoi(args[2]);
+            first.year = std::stoi(args[3]);
+            first.hour = std::stoi(args[4]);
+            first.minute = std::stoi(args[5]);
+            first.operation_number = std::stoi(args[6]);
+            RecurrenceRule rule;
+            std::string error;
+            if (!parseRecurrenceRule(args[7], args[8], rule, error)) {
+                out << RED << BOLD << "Error: " << RESET << error << std::endl;
+                return 1;
+            }
+            std::unique_lock<std::shared_mutex> lock(schedulerMutex);
+            JournalTransaction transaction(scheduler, appsFilename);
+            std::vector<Appointment> scheduled;
+            if (!scheduler.scheduleSeries(first, rule, &scheduled, out, out)) {
+                return 0;
+            }
+            if (!scheduler.appendAppointments(appsFilename, scheduled)) {
+                out << RED << BOLD << "CRITICAL WARNING: " << RESET << "Appointments were added to memory, but saving to file "
+                    << appsFilename << RED << " FAILED!" << RESET << std::endl;
+                return 2;
+            }
+            if (scheduler.journalSize() >= checkpointRecords) {
+                scheduler.checkpointAppointments(appsFilename);
+            }
+            // The fsync runs after both locks are released, so it is shared with the writers that follow
+            transaction.release();
+            lock.unlock();
+        } else if ((command == "cancel" && (args.size() == 6 || args.size() == 7)) ||
+                   (command == "reschedule" && (args.size() == 11 || args.size() == 12))) {
+            const size_t timeArgs = command == "cancel" ? 5 : 10;
+            int fields[10];
+            for (size_t i = 0; i < timeArgs; ++i) {
+                fields[i] = std::stoi(args[1 + i]);
+            }
+            std::unique_lock<std::shared_mutex> lock(schedulerMutex);
+            JournalTransaction transaction(scheduler, appsFilename);
+            int resourceId = -1;
+            if (args.size() == 2 + timeArgs) {
+                resourceId = scheduler.findResourceId(args[1 + timeArgs]);
+                if (resourceId < 0) {
+                    out << RED << BOLD << "Error: " << RESET << "Unknown chair or dentist '" << args[1 + timeArgs] << "'." << std::endl;
+                    return 1;
+                }
+            }
+            Appointment previous, moved;
+            bool changed = command == "cancel"
+                ? scheduler.cancelAppointment(fields[0], fields[1], fields[2], fields[3], fields[4], resourceId, &previous, out, out)
+                : scheduler.rescheduleAppointment(fields[0], fields[1], fields[2], fields[3], fields[4],
+                                                  fields[5], fields[6], fields[7], fields[8], fields[9], resourceId, &previous, &moved, out, out);
+            if (!changed) {
+                return 1;
+            }
+            if (!scheduler.appendCancellation(appsFilename, previous, command == "cancel" ? nullptr : &moved)) {
+                out << RED << BOLD << "CRITICAL WARNING: " << RESET << "Appointment was changed in memory, but saving to file "
+                    << appsFilename << RED << " FAILED!" << RESET << std::endl;
+                return 2;
+            }
+            if (scheduler.journalSize() >= checkpointRecords) {
+                scheduler.checkpointAppointments(appsFilename);
+            }
+            // The fsync runs after both locks are released, so it is shared with the writers that follow
+            transaction.release();
+            lock.unlock();
+        } else if (command == "save_and_exit" && args.size() == 1) {
+            // The server keeps running; only the checkpoint is performed
+            std::unique_lock<std::shared_mutex> lock(schedulerMutex);
+            JournalTransaction transaction(scheduler, appsFilename);
+            if (!scheduler.checkpointAppointments(appsFilename)) {
+                out << RED << BOLD << "Failed to save appointments to " << RESET << appsFilename << std::endl;
+                return 2;
+            }
+            out << GREEN << BOLD << "Appointments successfully saved to " << RESET << appsFilename << std::endl;
+        } else if (command == "server_stats" && args.size() == 1) {
+            reportLatency(out);
+        } else {
+            out << RED << BOLD << "Error: " << RESET << "Unknown command or wrong number of arguments for '" << command << "'" << std::endl;
+            return 1;
+        }
+    } catch (const std::invalid_argument&) {
+        out << RED << BOLD << "Error: " << RESET << "Invalid numeric argument. Make sure numeric parameters are correct." << std::endl;
+        return 1;
+    } catch (const std::out_of_range&) {
+        out << RED << BOLD << "Error: " << RESET << "Numeric argument out of allowed range." << std::endl;
+        return 1;
+    } catch (const std::exception& e) { // Anything else fails this command only; the server keeps its state and goes on
+        out << RED << BOLD << "Error: " << RESET << "Command '" << command << "' failed: " << e.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
+
+/**
+ * @brief Brings in what other processes wrote to the journal before a read; the exclusive lock is only taken when there is something new.
+ */
+void SchedulerServer::catchUp() {
+    {
+        std::shared_lock<std::shared_mutex> lock(schedulerMutex);
+        if (!scheduler.hasExternalChanges(appsFilename)) return;
+    }
+    std::unique_lock<std::shared_mutex> lock(schedulerMutex);
+    JournalTransaction transaction(scheduler, appsFilename); // Nothing is appended, so there is nothing to sync
+}
+
+/**
+ * @brief Brings the archived segments of a range into memory; the exclusive lock is only taken the first time.
+ */
+void SchedulerServer::loadArchivedRange(long fromDay, long toDay) {
+    {
+        std::shared_lock<std::shared_mutex> lock(schedulerMutex);
+        if (scheduler.isArchiveLoaded(fromDay, toDay)) return;
+    }
+    std::unique_lock<std::shared_mutex> lock(schedulerMutex);
+    scheduler.loadArchivedRange(fromDay, toDay);
+}
+
+/**
+ * @brief Adds one served command to the latency statistics.
+ */
+void SchedulerServer::recordLatency(const std::string& command, double micros) {
+    if (std::find(std::begin(SERVER_COMMANDS), std::end(SERVER_COMMANDS), command) == std::end(SERVER_COMMANDS)) {
+        return; // Whatever a client sends must not grow the table
+    }
+    std::lock_guard<std::mutex> lock(latencyMutex);
+    CommandLatency& entry = latency[command];
+    ++entry.count;
+    entry.totalMicros += micros;
+    if (micros > entry.maxMicros) entry.maxMicros = micros;
+}
+
+/**
+ * @brief Prints the per-command latency table.
+ */
+void SchedulerServer::reportLatency(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(latencyMutex);
+    out << CYAN << BOLD << "\nServer Latency:" << RESET << std::endl;
+    out << BLUE << "-----------------------------------------------------------------" << RESET << std::endl;
+    out << std::left << MAGENTA << BOLD << std::setw(22) << "Command" << std::setw(12) << "Count"
+        << std::setw(15) << "Mean (us)" << std::setw(15) << "Max (us)" << RESET << std::endl;
+    out << BLUE << "-----------------------------------------------------------------" << RESET << std::endl;
+    for (const auto& entry : latency) {
+        out << std::left << std::setw(22) << entry.first << std::setw(12) << entry.second.count
+            << std::fixed << std::setprecision(1) << std::setw(15) << entry.second.totalMicros / entry.second.count
+            << std::setw(15) << entry.second.maxMicros << std::endl;
+    }
+    out << BLUE << "-----------------------------------------------------------------" << RESET << "\n" << std::endl;
+}
+
+#ifndef _WIN32
+
+/**
+ * @brief Writes the whole buffer to a socket.
+ */
+static bool writeAll(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n <= 0) return false;
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief Serves a single request: one command line in, "<exit code>\n<output>" back.
+ */
+void SchedulerServer::handleClient(int clientFd) {
+    timeval timeout = { CLIENT_READ_TIMEOUT_SECONDS, 0 };
+    ::setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    std::string request;
+    char chunk[512];
+    while (request.find('\n') == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+        ssize_t n = ::read(clientFd, chunk, sizeof(chunk));
+        if (n < 0) { // Timed out or failed: a half-sent command is not run
+            ::close(clientFd);
+            return;
+        }
+        if (n == 0) break;
+        request.append(chunk, static_cast<size_t>(n));
+    }
+    size_t lineEnd = request.find('\n');
+    if (lineEnd == std::string::npos && request.size() >= MAX_REQUEST_BYTES) { // A cut-off command is not run
+        std::ostringstream out;
+        out << RED << BOLD << "Error: " << RESET << "Request is longer than " << MAX_REQUEST_BYTES << " bytes." << std::endl;
+        writeAll(clientFd, "1\n" + out.str());
+        ::close(clientFd);
+        return;
+    }
+    request = request.substr(0, lineEnd);
+
+    std::vector<std::string> args;
+    std::istringstream tokens(request);
+    std::string token;
+    while (tokens >> token) {
+        args.push_back(token);
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    std::ostringstream out;
+    int status = execute(args, out);
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+    if (!args.empty()) {
+        recordLatency(args[0], micros);
+    }
+
+    writeAll(clientFd, std::to_string(status) + "\n" + out.str());
+    ::close(clientFd);
+}
+
+/**
+ * @brief Listens on a Unix domain socket and serves the clients on a fixed pool of worker threads.
+ */
+bool SchedulerServer::run(const std::string& socketPath) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Socket path is too long: " << socketPath << std::endl;
+        return false;
+    }
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not create server socket." << std::endl;
+        return false;
+    }
+    std::remove(socketPath.c_str()); // Stale socket left by a previous run
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listenFd, 128) != 0) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not listen on " << socketPath << std::endl;
+        ::close(listenFd);
+        return false;
+    }
+
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    std::cerr << GREEN << BOLD << "Scheduler server listening on " << RESET << socketPath
+              << GREEN << " (" << scheduler.appointments.size() << " appointments loaded)." << RESET << std::endl;
+
+    // A fixed pool of workers serves the accepted clients; they are all joined before the final checkpoint,
+    // so no handler outlives the scheduler
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<int> pendingClients;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+    size_t workerCount = std::max(2u, std::thread::hardware_concurrency());
+    for (size_t w = 0; w < workerCount; ++w) {
+        workers.emplace_back([&]() {
+            for (;;) {
+                int clientFd;
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    queueReady.wait(lock, [&]() { return stopping || !pendingClients.empty(); });
+                    if (pendingClients.empty()) return; // Stopping, and every accepted client was served
+                    clientFd = pendingClients.front();
+                    pendingClients.pop_front();
+                }
+                handleClient(clientFd);
+            }
+        });
+    }
+
+    while (!stopRequested) {
+        pollfd pending = { listenFd, POLLIN, 0 };
+        if (::poll(&pending, 1, 200) <= 0) continue; // Wake up regularly to notice a stop request
+        int clientFd = ::accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) continue;
+        std::unique_lock<std::mutex> lock(queueMutex);
+        if (pendingClients.size() >= MAX_PENDING_CLIENTS) {
+            lock.unlock();
+            std::ostringstream out;
+            out << RED << BOLD << "Error: " << RESET << "Server is busy. Try again." << std::endl;
+            writeAll(clientFd, "1\n" + out.str());
+            ::close(clientFd);
+            continue;
+        }
+        pendingClients.push_back(clientFd);
+        lock.unlock();
+        queueReady.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    for (auto& worker : workers) worker.join();
+    ::close(listenFd);
+    std::remove(socketPath.c_str());
+    {
+        std::unique_lock<std::shared_mutex> lock(schedulerMutex);
+        JournalTransaction transaction(scheduler, appsFilename);
+        scheduler.checkpointAppointments(appsFilename);
+    }
+    reportLatency(std::cerr);
+    return true;
+}
+
+/**
+ * @brief Sends a command to a running server and prints its output.
+ */
+int forwardCommand(const std::string& socketPath, const std::vector<std::string>& args) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not connect to scheduler server at " << socketPath << std::endl;
+        if (fd >= 0) ::close(fd);
+        return 1;
+    }
+
+    std::string request;
+    for (size_t i = 0; i < args.size(); ++i) {
+        request += (i ? " " : "") + args[i];
+    }
+    request += "\n";
+    std::signal(SIGPIPE, SIG_IGN);
+    if (!writeAll(fd, request)) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not send command to scheduler server." << std::endl;
+        ::close(fd);
+        return 1;
+    }
+
+    std::string response;
+    char chunk[4096];
+    ssize_t n;
+    while ((n = ::read(fd, chunk, sizeof(chunk))) > 0) {
+        response.append(chunk, static_cast<size_t>(n));
+    }
+    ::close(fd);
+
+    size_t statusEnd = response.find('\n');
+    if (statusEnd == std::string::npos) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Scheduler server closed the connection without a reply." << std::endl;
+        return 1;
+    }
+    std::cout << response.substr(statusEnd + 1) << std::flush;
+    return std::atoi(response.substr(0, statusEnd).c_str());
+}
+
+#else
+
+void SchedulerServer::handleClient(int) {}
+
+bool SchedulerServer::run(const std::string&) {
+    std::cerr << RED << BOLD << "Error: " << RESET << "Server mode needs Unix domain sockets, which this build does not support." << std::endl;
+    return false;
+}
+
+int forwardCommand(const std::string&, const std::vector<std::string>&) {
+    std::cerr << RED << BOLD << "Error: " << RESET << "Client mode needs Unix domain sockets, which this build does not support." << std::endl;
+    return 1;
+}
+
+#endif
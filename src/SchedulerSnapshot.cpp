@@ -0,0 +1,203 @@
+#include "Scheduler.h"
+#include "BinarySnapshot.h"
+#include "MappedFile.h"
+#include "Instrumentation.h"
+#include <fstream>      // For std::ofstream
+#include <iostream>     // For std::cerr, std::endl
+#include <cstring>      // For memcmp, memcpy, strncpy
+#include <cstdio>       // For std::rename, std::remove
+#include <sys/stat.h>   // For stat
+
+// ANSI Color codes
+const std::string RESET = "\033[0m";
+const std::string RED = "\033[31m";
+const std::string YELLOW = "\033[33m";
+const std::string BOLD = "\033[1m";
+
+/**
+ * @brief Reads the size and modification time used to detect a stale snapshot.
+ *
+ * The time is kept in nanoseconds: an append that keeps the size and lands in the same second as the
+ * snapshot would otherwise go unnoticed. Platforms without sub-second times fall back to whole seconds.
+ */
+static bool fileStamp(const std::string& filename, uint64_t& size, int64_t& modified) {
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0) {
+        return false;
+    }
+    size = static_cast<uint64_t>(st.st_size);
+#if defined(_WIN32)
+    modified = static_cast<int64_t>(st.st_mtime) * 1000000000LL;
+#elif defined(__APPLE__)
+    modified = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+    modified = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+    return true;
+}
+
+/**
+ * @brief Returns the binary snapshot file that accompanies a text appointments file.
+ */
+std::string Scheduler::binarySnapshotFileName(const std::string& filename) {
+    return filename + ".bin";
+}
+
+/**
+ * @brief Writes the current appointments as a binary snapshot of the text file.
+ */
+bool Scheduler::saveBinarySnapshot(const std::string& filename) const {
+    ScopedTimer timer(Phase::SaveSnapshot);
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.operationCount = static_cast<uint32_t>(operations.size());
+    header.resourceCount = static_cast<uint32_t>(resources.size());
+    auto first = firstActive(); // The snapshot mirrors the active file, without archived appointments loaded on demand
+    header.appointmentCount = static_cast<uint64_t>(appointments.cend() - first);
+    if (!fileStamp(filename, header.sourceSize, header.sourceModified)) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Appointments file " << filename << " must exist before building a binary snapshot." << std::endl;
+        return false;
+    }
+
+    std::string body;
+    body.reserve(operations.size() * sizeof(SnapshotOperation) + resources.size() * sizeof(SnapshotResource) +
+                 header.appointmentCount * sizeof(SnapshotAppointment));
+    for (const auto& op : operations) {
+        SnapshotOperation rec;
+        memset(&rec, 0, sizeof(rec));
+        strncpy(rec.name, op.name, sizeof(rec.name) - 1);
+        rec.price = op.price;
+        rec.duration = op.duration;
+        body.append(reinterpret_cast<const char*>(&rec), sizeof(rec));
+    }
+    for (const auto& resource : resources) {
+        SnapshotResource rec;
+        memset(&rec, 0, sizeof(rec));
+        strncpy(rec.name, resource.name, sizeof(rec.name) - 1);
+        body.append(reinterpret_cast<const char*>(&rec), sizeof(rec));
+    }
+    for (auto it = first; it != appointments.cend(); ++it) {
+        const Appointment& app = *it;
+        if (app.start < INT32_MIN || app.start > INT32_MAX) {
+            int day, month, year;
+            app.date(day, month, year);
+            std::cerr << RED << BOLD << "Error: " << RESET << "Appointment on " << day << "/" << month << "/" << year
+                      << " cannot be stored in a binary snapshot." << std::endl;
+            return false;
+        }
+        SnapshotAppointment rec;
+        rec.start = static_cast<int32_t>(app.start);
+        rec.operationIndex = static_cast<uint16_t>(app.operationId);
+        rec.resourceIndex = static_cast<uint16_t>(app.resourceId);
+        body.append(reinterpret_cast<const char*>(&rec), sizeof(rec));
+    }
+    header.checksum = snapshotChecksum(body.data(), body.size());
+
+    const std::string snapshotFilename = binarySnapshotFileName(filename);
+    const std::string tempFilename = snapshotFilename + ".tmp";
+    std::ofstream outFile(tempFilename, std::ios::binary);
+    if (!outFile) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not open binary snapshot for saving: " << tempFilename << std::endl;
+        return false;
+    }
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    outFile.write(body.data(), body.size());
+    outFile.close();
+    Instrumentation::add(Counter::BytesWritten, sizeof(header) + body.size());
+    if (outFile.fail()) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not write binary snapshot: " << tempFilename << std::endl;
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(snapshotFilename.c_str()); // rename does not replace an existing file there
+#endif
+    if (std::rename(tempFilename.c_str(), snapshotFilename.c_str()) != 0) {
+        std::cerr << RED << BOLD << "Error: " << RESET << "Could not replace binary snapshot: " << snapshotFilename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Loads appointments from the binary snapshot if it is present and matches the text file.
+ */
+bool Scheduler::loadBinarySnapshot(const std::string& filename) {
+    ScopedTimer timer(Phase::LoadSnapshot);
+    const std::string snapshotFilename = binarySnapshotFileName(filename);
+    MappedFile file;
+    if (!file.open(snapshotFilename)) {
+        return false;
+    }
+    Instrumentation::add(Counter::BytesRead, file.size());
+
+    SnapshotHeader header;
+    if (file.size() < sizeof(header)) {
+        std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Binary snapshot " << snapshotFilename << " is truncated. Falling back to " << filename << "." << std::endl;
+        return false;
+    }
+    memcpy(&header, file.data(), sizeof(header));
+    uint64_t sourceSize = 0;
+    int64_t sourceModified = 0;
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION) {
+        std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Binary snapshot " << snapshotFilename << " has an unknown format. Falling back to " << filename << "." << std::endl;
+        return false;
+    }
+    if (!fileStamp(filename, sourceSize, sourceModified) || sourceSize != header.sourceSize || sourceModified != header.sourceModified) {
+        return false; // The text file was edited after the snapshot was built
+    }
+
+    const char* body = file.data() + sizeof(header);
+    size_t bodySize = file.size() - sizeof(header);
+    if (bodySize != header.operationCount * sizeof(SnapshotOperation) + header.resourceCount * sizeof(SnapshotResource) +
+                    header.appointmentCount * sizeof(SnapshotAppointment) ||
+        snapshotChecksum(body, bodySize) != header.checksum) {
+        std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Binary snapshot " << snapshotFilename << " is corrupted. Falling back to " << filename << "." << std::endl;
+        return false;
+    }
+
+    // Resolve the snapshot's operation table against the current catalog once
+    std::vector<int> catalog(header.operationCount);
+    for (uint32_t i = 0; i < header.operationCount; ++i) {
+        SnapshotOperation rec;
+        memcpy(&rec, body + i * sizeof(SnapshotOperation), sizeof(rec));
+        rec.name[sizeof(rec.name) - 1] = '\0';
+        catalog[i] = findOperationId(rec.name);
+        if (catalog[i] < 0) {
+            std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Operation '" << rec.name << "' from the binary snapshot was not found. Its appointments are skipped." << std::endl;
+        }
+    }
+
+    // Same for the resource table; the clinic's chairs may have changed since the snapshot was built
+    const char* resourceTable = body + header.operationCount * sizeof(SnapshotOperation);
+    std::vector<int> chairs(header.resourceCount);
+    for (uint32_t i = 0; i < header.resourceCount; ++i) {
+        SnapshotResource rec;
+        memcpy(&rec, resourceTable + i * sizeof(SnapshotResource), sizeof(rec));
+        rec.name[sizeof(rec.name) - 1] = '\0';
+        chairs[i] = findResourceId(rec.name);
+        if (chairs[i] < 0) {
+            std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Resource '" << rec.name << "' from the binary snapshot was not found. Its appointments are skipped." << std::endl;
+        }
+    }
+
+    const char* records = resourceTable + header.resourceCount * sizeof(SnapshotResource);
+    appointments.reserve(appointments.size() + header.appointmentCount);
+    for (uint64_t i = 0; i < header.appointmentCount; ++i) {
+        SnapshotAppointment rec;
+        memcpy(&rec, records + i * sizeof(SnapshotAppointment), sizeof(rec));
+        if (rec.operationIndex < catalog.size() && catalog[rec.operationIndex] >= 0 &&
+            rec.resourceIndex < chairs.size() && chairs[rec.resourceIndex] >= 0) {
+            Appointment app;
+            app.start = rec.start;
+            app.operationId = catalog[rec.operationIndex];
+            app.resourceId = static_cast<int16_t>(chairs[rec.resourceIndex]);
+            app.duration = static_cast<int16_t>(operations[app.operationId].duration);
+            appointments.push_back(app);
+        }
+    }
+    Instrumentation::add(Counter::SnapshotRecords, header.appointmentCount);
+    return true;
+}
@@ -0,0 +1,132 @@
+#include "Scheduler.h"
+#include "Calendar.h"
+#include "Instrumentation.h"
+#include <iostream>     // For std::endl
+#include <iomanip>      // For std::setw, std::setprecision
+#include <sstream>      // For std::ostringstream
+#include <algorithm>    // For std::max, std::min
+
+// ANSI Color codes
+const std::string RESET = "\033[0m";
+const std::string GREEN = "\033[32m";
+const std::string YELLOW = "\033[33m";
+const std::string BLUE = "\033[34m";
+const std::string MAGENTA = "\033[35m";
+const std::string CYAN = "\033[36m";
+const std::string WHITE = "\033[37m";
+const std::string BOLD = "\033[1m";
+
+const std::string STATS_RULE = "---------------------------------------------------------------------------";
+
+// Totals of one row of the stats table
+struct StatsRow {
+    long long appointments = 0;
+    long long minutes = 0;
+    double revenue = 0.0;
+};
+
+/**
+ * @brief Formats a day number as dd/mm/yyyy.
+ */
+static std::string formatDay(long dayNumber) {
+    int day, month, year;
+    civilFromDays(dayNumber, day, month, year);
+    std::ostringstream text;
+    text << std::setfill('0') << std::setw(2) << day << "/" << std::setw(2) << month << "/" << std::setw(4) << year;
+    return text.str();
+}
+
+/**
+ * @brief Prints one row: label, appointments, booked minutes, revenue and the last column.
+ */
+static void printStatsRow(std::ostream& out, const std::string& label, const StatsRow& row, double percent) {
+    out << std::left
+        << WHITE << std::setw(25) << label
+        << GREEN << std::setw(15) << row.appointments
+        << CYAN << std::setw(15) << row.minutes
+        << YELLOW << std::fixed << std::setprecision(2) << std::setw(15) << row.revenue
+        << MAGENTA << std::setprecision(1) << percent << "%" << RESET << std::endl;
+}
+
+/**
+ * @brief Sums the aggregates of an inclusive range of days; prices come from the current catalog.
+ */
+static StatsRow statsRow(const ClinicStats& stats, const std::vector<Operation>& operations, long fromDay, long toDay,
+                         std::vector<long long>& operationCounts, std::vector<long long>& resourceMinutes) {
+    stats.rangeTotals(fromDay, toDay, operationCounts, resourceMinutes);
+    StatsRow row;
+    for (size_t i = 0; i < operationCounts.size(); ++i) {
+        row.appointments += operationCounts[i];
+        row.revenue += operationCounts[i] * static_cast<double>(operations[i].price);
+    }
+    for (long long minutes : resourceMinutes) {
+        row.minutes += minutes;
+    }
+    return row;
+}
+
+/**
+ * @brief Displays revenue and utilization for a date range from the incremental aggregates.
+ */
+void Scheduler::displayStats(const StatsQuery& query, std::ostream& out) const {
+    ScopedTimer timer(Phase::Output);
+    // Utilization is measured against the whole day of every resource, the same 24h grid the booking checks use
+    const double capacityPerDay = static_cast<double>(resources.size()) * DayOccupancy::MINUTES_PER_DAY;
+    std::vector<long long> operationCounts;
+    std::vector<long long> resourceMinutes;
+    const StatsRow total = statsRow(stats, operations, query.fromDay, query.toDay, operationCounts, resourceMinutes);
+    const long rangeDays = query.toDay - query.fromDay + 1;
+
+    out << CYAN << BOLD << "\nStatistics " << formatDay(query.fromDay) << " - " << formatDay(query.toDay) << ":" << RESET << std::endl;
+    out << BLUE << STATS_RULE << RESET << std::endl;
+    out << std::left << MAGENTA << BOLD
+        << std::setw(25) << (query.grouping == StatsGrouping::Day ? "Day" : query.grouping == StatsGrouping::Month ? "Month" : query.grouping == StatsGrouping::Operation ? "Operation" : "Resource")
+        << std::setw(15) << "Appointments"
+        << std::setw(15) << "Booked (min)"
+        << std::setw(15) << "Revenue (RON)"
+        << (query.grouping == StatsGrouping::Operation ? "Revenue share" : "Utilization") << RESET << std::endl;
+    out << BLUE << STATS_RULE << RESET << std::endl;
+
+    if (query.grouping == StatsGrouping::Total) {
+        // Only booked time is split by resource; appointment counts and revenue are per operation
+        for (size_t r = 0; r < resources.size(); ++r) {
+            out << std::left << WHITE << std::setw(25) << resources[r].name << GREEN << std::setw(15) << "-"
+                << CYAN << std::setw(15) << resourceMinutes[r] << YELLOW << std::setw(15) << "-" << MAGENTA << std::fixed << std::setprecision(1)
+                << 100.0 * resourceMinutes[r] / (static_cast<double>(DayOccupancy::MINUTES_PER_DAY) * rangeDays) << "%" << RESET << std::endl;
+        }
+    } else if (query.grouping == StatsGrouping::Operation) {
+        for (size_t i = 0; i < operations.size(); ++i) {
+            if (operationCounts[i] == 0) continue;
+            StatsRow row;
+            row.appointments = operationCounts[i];
+            row.minutes = operationCounts[i] * operations[i].duration;
+            row.revenue = operationCounts[i] * static_cast<double>(operations[i].price);
+            printStatsRow(out, operations[i].name, row, total.revenue > 0 ? 100.0 * row.revenue / total.revenue : 0.0);
+        }
+    } else if (!stats.empty()) {
+        // Only the covered days can hold appointments, so the walk skips straight over the others
+        std::vector<long long> counts;
+        std::vector<long long> minutes;
+        for (long periodStart = stats.nextCoveredDay(query.fromDay); periodStart <= query.toDay;) {
+            long periodEnd = periodStart;
+            std::string label = formatDay(periodStart);
+            if (query.grouping == StatsGrouping::Month) {
+                int day, month, year;
+                civilFromDays(periodStart, day, month, year);
+                periodStart = std::max(query.fromDay, daysFromCivil(1, month, year)); // A stray record can fall mid-month
+                periodEnd = std::min(query.toDay, daysFromCivil(daysInMonth(month, year), month, year));
+                label = label.substr(3);
+            }
+            StatsRow row = statsRow(stats, operations, periodStart, periodEnd, counts, minutes);
+            if (row.appointments > 0) {
+                printStatsRow(out, label, row, 100.0 * row.minutes / (capacityPerDay * (periodEnd - periodStart + 1)));
+            }
+            periodStart = stats.nextCoveredDay(periodEnd + 1);
+        }
+    }
+
+    out << BLUE << STATS_RULE << RESET << std::endl;
+    printStatsRow(out, "Total", total, query.grouping == StatsGrouping::Operation ? (total.revenue > 0 ? 100.0 : 0.0)
+                                                                                   : 100.0 * total.minutes / (capacityPerDay * rangeDays));
+    out << BLUE << STATS_RULE << RESET << "\n" << std::endl;
+}
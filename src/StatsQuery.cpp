@@ -0,0 +1,35 @@
+#include "StatsQuery.h"
+#include "Calendar.h"
+
+/**
+ * @brief Parses the stats arguments that follow the command name.
+ */
+bool parseStatsQuery(const std::vector<std::string>& args, StatsQuery& query, std::string& error) {
+    if (args.size() != 2 && args.size() != 3) {
+        error = "stats needs a date range: <from d/m/y> <to d/m/y> [by=day|month|operation].";
+        return false;
+    }
+    int day, month, year;
+    for (size_t i = 0; i < 2; ++i) {
+        if (!parseDate(args[i], day, month, year)) {
+            error = "Invalid date '" + args[i] + "' (expected day/month/year).";
+            return false;
+        }
+        (i == 0 ? query.fromDay : query.toDay) = daysFromCivil(day, month, year);
+    }
+    if (query.toDay < query.fromDay) {
+        error = "The end date is before the start date.";
+        return false;
+    }
+    if (args.size() == 3) {
+        const std::string& grouping = args[2];
+        if (grouping == "by=day") query.grouping = StatsGrouping::Day;
+        else if (grouping == "by=month") query.grouping = StatsGrouping::Month;
+        else if (grouping == "by=operation") query.grouping = StatsGrouping::Operation;
+        else {
+            error = "Unknown grouping '" + grouping + "' (expected by=day, by=month or by=operation).";
+            return false;
+        }
+    }
+    return true;
+}
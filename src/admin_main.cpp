@@ -1,11 +1,21 @@
 #include <iostream>
 #include <string>
 #include <stdexcept> // For std::invalid_argument, std::out_of_range
+#include <vector>
 #include "Scheduler.h"
+#include "JournalTransaction.h"
+#include "Calendar.h"
+#include "TextFields.h"
+#include "SchedulerServer.h"
+#include "Instrumentation.h"
 
 // Constants for file names - expected to be in the same directory as the executable
 const std::string OPS_FILENAME = "op_details.txt";
+const std::string RES_FILENAME = "res_details.txt"; // Optional - without it there is a single chair
 const std::string APPS_FILENAME = "app_details.txt";
+const std::string SOCKET_FILENAME = "scheduler.sock";
+// Journal records accumulated before the server rewrites the snapshot
+const size_t JOURNAL_CHECKPOINT_RECORDS = 1000;
 
 // ANSI Color codes
 const std::string RESET = "\033[0m";
@@ -20,10 +30,21 @@ const std::string BOLD = "\033[1m";
 
 void printAdminUsage() {
     std::cerr << CYAN << BOLD << "Usage Admin App: " << RESET << "./admin_app <command> [arguments...]" << std::endl;
+    std::cerr << CYAN << BOLD << "                 " << RESET << "./admin_app --connect <socket> <command> [arguments...]" << std::endl;
+    std::cerr << CYAN << BOLD << "                 " << RESET << "./admin_app --stats[=<report.json>] <command> [arguments...]  (timing report on stderr)" << std::endl;
     std::cerr << BLUE << BOLD << "Available commands for admin:" << RESET << std::endl;
     std::cerr << GREEN << "  view_operations          " << RESET << "- Display available dental operations" << std::endl;
-    std::cerr << GREEN << "  view_history             " << RESET << "- Display history of all appointments" << std::endl;
-    std::cerr << GREEN << "  save_and_exit            " << RESET << "- Save all appointments and close the program" << std::endl;
+    std::cerr << GREEN << "  view_history [options]   " << RESET << "- Display history of all appointments" << std::endl;
+    std::cerr << GREEN << "      --from <d/m/y> --to <d/m/y> --op <name|nr> --offset <n> --limit <n> --format table|csv|json" << std::endl;
+    std::cerr << GREEN << "  stats <from d/m/y> <to d/m/y> [by=day|month|operation]" << RESET << std::endl;
+    std::cerr << GREEN << "                           " << RESET << "- Revenue, booked time and utilization for a date range" << std::endl;
+    std::cerr << GREEN << "  availability_map <from d/m/y> <to d/m/y> [min_gap]" << RESET << std::endl;
+    std::cerr << GREEN << "                           " << RESET << "- Free minutes and longest free run of every day (slots of min_gap minutes, default 30)" << std::endl;
+    std::cerr << GREEN << "  archive <before d/m/y>   " << RESET << "- Move appointments before a date into sealed monthly segments (" << APPS_FILENAME << ".archive/)" << std::endl;
+    std::cerr << GREEN << "  save_and_exit            " << RESET << "- Save all appointments (folding in the journal) and close the program" << std::endl;
+    std::cerr << GREEN << "  build_snapshot           " << RESET << "- Save all appointments and build the binary snapshot used for fast loading" << std::endl;
+    std::cerr << GREEN << "  serve [socket]           " << RESET << "- Keep the scheduler in memory and serve commands on a Unix socket (default " << SOCKET_FILENAME << ")" << std::endl;
+    std::cerr << GREEN << "  server_stats             " << RESET << "- Per-command latency of a running server (with --connect)" << std::endl;
     // "Adding available dental operations" [cite: 1] is done by manually editing op_details.txt
     // "Loading and displaying scheduled appointments" [cite: 1] is covered by view_history
     // "Saving the appointment history" [cite: 1] is covered by save_and_exit
@@ -33,11 +54,21 @@ int main(int argc, char* argv[]) {
     std::ios_base::sync_with_stdio(false);
     std::cin.tie(NULL);
 
+    // --stats must come first; the report is printed when main returns
+    InstrumentationReport statsReport;
+    statsReport.parseFlag(argc, argv);
+
     if (argc < 2) {
         printAdminUsage();
         return 1;
     }
 
+    // Thin client mode: forward the command to a running scheduler server
+    if (std::string(argv[1]) == "--connect") {
+        if (argc < 4) { printAdminUsage(); return 1; }
+        return forwardCommand(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+    }
+
     Scheduler scheduler;
 
     // Admin loads operations and appointments at startup
@@ -45,6 +76,7 @@ int main(int argc, char* argv[]) {
         std::cerr << RED << BOLD << "Critical error: " << RESET << "Could not load operations from " << OPS_FILENAME << ". Please check the file." << std::endl;
         return 1;
     }
+    scheduler.loadResources(RES_FILENAME);
     scheduler.loadAppointments(APPS_FILENAME); // It's OK if app_details.txt doesn't exist initially
 
     std::string command = argv[1];
@@ -54,17 +86,83 @@ int main(int argc, char* argv[]) {
             if (argc != 2) { printAdminUsage(); return 1; }
             scheduler.displayOperations();
         } else if (command == "view_history") {
-            if (argc != 2) { printAdminUsage(); return 1; }
-            scheduler.displayAppointmentHistory();
+            HistoryQuery query;
+            std::string error;
+            if (!parseHistoryQuery(std::vector<std::string>(argv + 2, argv + argc), query, error)) {
+                std::cerr << RED << BOLD << "Error: " << RESET << error << std::endl;
+                printAdminUsage();
+                return 1;
+            }
+            scheduler.loadArchivedRange(query.fromDay, query.toDay);
+            if (!scheduler.displayAppointmentHistory(query)) {
+                return 1;
+            }
+        } else if (command == "stats") {
+            StatsQuery query;
+            std::string error;
+            if (!parseStatsQuery(std::vector<std::string>(argv + 2, argv + argc), query, error)) {
+                std::cerr << RED << BOLD << "Error: " << RESET << error << std::endl;
+                printAdminUsage();
+                return 1;
+            }
+            scheduler.loadArchivedRange(query.fromDay, query.toDay);
+            scheduler.displayStats(query);
+        } else if (command == "availability_map") {
+            if (argc != 4 && argc != 5) { printAdminUsage(); return 1; }
+            int fromDay, fromMonth, fromYear, toDay, toMonth, toYear;
+            if (!parseDate(argv[2], fromDay, fromMonth, fromYear) || !parseDate(argv[3], toDay, toMonth, toYear)) {
+                std::cerr << RED << BOLD << "Error: " << RESET << "Dates must be valid and written as day/month/year." << std::endl;
+                return 1;
+            }
+            const long first = daysFromCivil(fromDay, fromMonth, fromYear);
+            const long last = daysFromCivil(toDay, toMonth, toYear);
+            int minGap = 30;
+            if (argc == 5 && !parseField(argv[4], minGap)) {
+                minGap = 0; // Not a number: reported with the gap range below
+            }
+            if (!scheduler.displayAvailabilityMap(first, last, minGap)) {
+                return 1;
+            }
+        } else if (command == "archive") {
+            if (argc != 3) { printAdminUsage(); return 1; }
+            int day, month, year;
+            if (!parseDate(argv[2], day, month, year)) {
+                std::cerr << RED << BOLD << "Error: " << RESET << "Invalid date '" << argv[2] << "' (expected day/month/year)." << std::endl;
+                return 1;
+            }
+            JournalTransaction transaction(scheduler, APPS_FILENAME); // The checkpoint must not drop bookings made since the load
+            size_t archived = 0;
+            if (!scheduler.archiveAppointments(APPS_FILENAME, daysFromCivil(day, month, year), archived)) {
+                std::cout << RED << BOLD << "Failed to archive appointments of " << RESET << APPS_FILENAME << std::endl;
+                return 2;
+            }
+            std::cout << GREEN << BOLD << "Archived " << archived << " appointments before " << RESET << argv[2]
+                      << GREEN << BOLD << " into " << RESET << APPS_FILENAME << ".archive/" << std::endl;
         } else if (command == "save_and_exit") {
             if (argc != 2) { printAdminUsage(); return 1; }
-            if (scheduler.saveAppointments(APPS_FILENAME)) {
+            JournalTransaction transaction(scheduler, APPS_FILENAME);
+            if (scheduler.checkpointAppointments(APPS_FILENAME)) {
                 std::cout << GREEN << BOLD << "Appointments successfully saved to " << RESET << APPS_FILENAME << GREEN << ". Admin app is closing." << RESET << std::endl;
             } else {
                 std::cout << RED << BOLD << "Failed to save appointments to " << RESET << APPS_FILENAME << RED << ". Admin app is closing anyway." << RESET << std::endl;
                 return 2; // Error code for save failure
             }
             return 0; // Normal exit after save_and_exit
+        } else if (command == "build_snapshot") {
+            if (argc != 2) { printAdminUsage(); return 1; }
+            JournalTransaction transaction(scheduler, APPS_FILENAME);
+            if (!scheduler.checkpointAppointments(APPS_FILENAME, true)) { // Writes the binary snapshot exactly once
+                std::cout << RED << BOLD << "Failed to build the binary snapshot of " << RESET << APPS_FILENAME << std::endl;
+                return 2;
+            }
+            std::cout << GREEN << BOLD << "Binary snapshot of " << RESET << APPS_FILENAME << GREEN << " built ("
+                      << scheduler.appointments.size() << " appointments)." << RESET << std::endl;
+        } else if (command == "serve") {
+            if (argc > 3) { printAdminUsage(); return 1; }
+            SchedulerServer server(scheduler, APPS_FILENAME, JOURNAL_CHECKPOINT_RECORDS);
+            if (!server.run(argc == 3 ? argv[2] : SOCKET_FILENAME)) {
+                return 1;
+            }
         } else {
             std::cerr << RED << BOLD << "Error: " << RESET << "Unknown admin command '" << command << "'" << std::endl;
             printAdminUsage();
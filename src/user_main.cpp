@@ -2,11 +2,21 @@
 #include <string>
 #include <stdexcept> // For std::invalid_argument, std::out_of_range
 #include <iomanip>   // For std::setfill, std::setw
+#include <fstream>   // For std::ifstream
+#include <sstream>   // For std::istringstream
+#include <vector>
 #include "Scheduler.h"
+#include "JournalTransaction.h"
+#include "Calendar.h"
+#include "SchedulerServer.h"
+#include "Instrumentation.h"
 
 // Constants for file names - expected to be in the same directory as the executable
 const std::string OPS_FILENAME = "op_details.txt";
+const std::string RES_FILENAME = "res_details.txt"; // Optional - without it there is a single chair
 const std::string APPS_FILENAME = "app_details.txt";
+// Journal records accumulated before the snapshot is rewritten automatically
+const size_t JOURNAL_CHECKPOINT_RECORDS = 1000;
 
 // ANSI Color codes
 const std::string RESET = "\033[0m";
@@ -21,22 +31,46 @@ const std::string BOLD = "\033[1m";
 
 void printUserUsage() {
     std::cerr << CYAN << BOLD << "Usage User App: " << RESET << "./user_app <command> [arguments...]" << std::endl;
+    std::cerr << CYAN << BOLD << "                " << RESET << "./user_app --connect <socket> <command> [arguments...]" << std::endl;
+    std::cerr << CYAN << BOLD << "                " << RESET << "./user_app --stats[=<report.json>] <command> [arguments...]  (timing report on stderr)" << std::endl;
     std::cerr << BLUE << BOLD << "Available commands for user:" << RESET << std::endl;
     std::cerr << GREEN << "  view_operations                                          " << RESET << "- Display available dental operations" << std::endl;
     std::cerr << GREEN << "  check_availability <day> <month> <year> <hour> <minute>  " << RESET << "- Check if a time slot is available [cite: 1]" << std::endl;
     std::cerr << GREEN << "  schedule <day> <month> <year> <hour> <minute> <op_nr>    " << RESET << "- Schedule a new appointment [cite: 1]" << std::endl;
-    std::cerr << GREEN << "  view_history                                             " << RESET << "- Display appointment history [cite: 1]" << std::endl;
+    std::cerr << GREEN << "  schedule_batch <file>                                    " << RESET << "- Schedule every '<day> <month> <year> <hour> <minute> <op_nr>' line of a file" << std::endl;
+    std::cerr << GREEN << "  schedule_series <day> <month> <year> <hour> <minute> <op_nr> <every> <count|until d/m/y>" << RESET << std::endl;
+    std::cerr << GREEN << "                                                           " << RESET << "- Book a recurring series (every: 1w, 14d, 1m...) all-or-nothing" << std::endl;
+    std::cerr << GREEN << "  plan <file> [requests|minutes]                           " << RESET << "- Place a waiting list of '<operation> <earliest d/m/y> <latest d/m/y> [8-12]' lines" << std::endl;
+    std::cerr << GREEN << "                                                           " << RESET << "  maximizing the requests (default) or the minutes booked" << std::endl;
+    std::cerr << GREEN << "                                                           " << RESET << "  (requests whose windows overlap on a shared chair are planned together)" << std::endl;
+    std::cerr << GREEN << "  cancel <day> <month> <year> <hour> <minute> [resource]     " << RESET << "- Cancel the appointment that starts at that time" << std::endl;
+    std::cerr << GREEN << "  reschedule <day> <month> <year> <hour> <minute> <new_day> <new_month> <new_year> <new_hour> <new_minute> [resource]" << RESET << std::endl;
+    std::cerr << GREEN << "                                                           " << RESET << "- Move an appointment to a new date and time" << std::endl;
+    std::cerr << GREEN << "  find_slots <op_nr> <from d/m/y> <to d/m/y> [count]      " << RESET << "- List the earliest free slots for an operation (default 10)" << std::endl;
+    std::cerr << GREEN << "  view_history [options]                                   " << RESET << "- Display appointment history [cite: 1]" << std::endl;
+    std::cerr << GREEN << "      --from <d/m/y> --to <d/m/y> --op <name|nr>           " << RESET << "  filter by date range and operation" << std::endl;
+    std::cerr << GREEN << "      --offset <n> --limit <n> --format table|csv|json     " << RESET << "  page through and export the result" << std::endl;
 }
 
 int main(int argc, char* argv[]) {
     std::ios_base::sync_with_stdio(false);
     std::cin.tie(NULL);
 
+    // --stats must come first; the report is printed when main returns
+    InstrumentationReport statsReport;
+    statsReport.parseFlag(argc, argv);
+
     if (argc < 2) {
         printUserUsage();
         return 1;
     }
 
+    // Thin client mode: forward the command to a running scheduler server
+    if (std::string(argv[1]) == "--connect") {
+        if (argc < 4) { printUserUsage(); return 1; }
+        return forwardCommand(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+    }
+
     Scheduler scheduler;
 
     // User loads operations and appointments at startup
@@ -44,6 +78,7 @@ int main(int argc, char* argv[]) {
         std::cerr << RED << BOLD << "Critical error: " << RESET << "Could not load operations from " << OPS_FILENAME << ". The program cannot continue." << std::endl;
         return 1;
     }
+    scheduler.loadResources(RES_FILENAME);
     scheduler.loadAppointments(APPS_FILENAME);
 
     std::string command = argv[1];
@@ -60,20 +95,7 @@ int main(int argc, char* argv[]) {
             int hour = std::stoi(argv[5]);
             int minute = std::stoi(argv[6]);
 
-            if (scheduler.isExactMinuteAvailable(day, month, year, hour, minute)) {
-                std::cout << GREEN << BOLD << "Time slot (time "
-                          << std::setfill('0') << std::setw(2) << hour << ":"
-                          << std::setfill('0') << std::setw(2) << minute
-                          << " on " << day << "/" << month << "/" << year 
-                          << ") is AVAILABLE" << RESET << GREEN << " (exact minute is not covered)." << RESET << std::endl;
-            } else {
-                std::cout << RED << BOLD << "Time slot (time "
-                          << std::setfill('0') << std::setw(2) << hour << ":"
-                          << std::setfill('0') << std::setw(2) << minute
-                          << " on " << day << "/" << month << "/" << year 
-                          << ") is NOT AVAILABLE" << RESET << RED << " (exact minute is covered)." << RESET << std::endl;
-            }
-            std::cout << std::setfill(' '); // Reset fill character
+            scheduler.reportMinuteAvailability(day, month, year, hour, minute);
         } else if (command == "schedule") {
             if (argc != 8) { printUserUsage(); return 1; }
             int day = std::stoi(argv[2]);
@@ -83,19 +105,251 @@ int main(int argc, char* argv[]) {
             int minute = std::stoi(argv[6]);
             int op_num = std::stoi(argv[7]);
 
-            if (scheduler.scheduleAppointment(day, month, year, hour, minute, op_num)) {
+            // The slot is checked again against what other processes booked since the load
+            JournalTransaction transaction(scheduler, APPS_FILENAME);
+            Appointment scheduled;
+            if (scheduler.scheduleAppointment(day, month, year, hour, minute, op_num, &scheduled)) {
                 // According to "app_details.txt: Updated with every new appointment"[cite: 12], we save automatically.
-                if (!scheduler.saveAppointments(APPS_FILENAME)) {
+                // Only the new record is appended to the journal; the snapshot is rewritten periodically.
+                if (!scheduler.appendAppointment(APPS_FILENAME, scheduled)) {
                     std::cerr << RED << BOLD << "CRITICAL WARNING: " << RESET << "Appointment was added to memory, but automatic saving to file "
                               << APPS_FILENAME << RED << " FAILED!" << RESET << std::endl;
                     std::cerr << YELLOW << "Please contact the administrator." << RESET << std::endl;
+                } else if (scheduler.journalSize() >= JOURNAL_CHECKPOINT_RECORDS) {
+                    scheduler.checkpointAppointments(APPS_FILENAME);
+                }
+            }
+        } else if (command == "schedule_batch") {
+            if (argc != 3) { printUserUsage(); return 1; }
+            std::ifstream batchFile(argv[2]);
+            if (!batchFile) {
+                std::cerr << RED << BOLD << "Error: " << RESET << "Could not open batch file: " << argv[2] << std::endl;
+                return 1;
+            }
+
+            // Format per line: <day> <month> <year> <hour> <minute> <op_nr>
+            std::vector<BookingRequest> requests;
+            std::vector<int> requestLines;
+            std::string line;
+            int lineNumber = 0;
+            while (std::getline(batchFile, line)) {
+                ++lineNumber;
+                std::istringstream fields(line);
+                BookingRequest request;
+                std::string extra;
+                if (!(fields >> request.day >> request.month >> request.year >> request.hour >> request.minute >> request.operation_number)) {
+                    if (line.find_first_not_of(" \t\r") != std::string::npos) {
+                        std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Line " << lineNumber << " of " << argv[2] << " is malformed and was skipped." << std::endl;
+                    }
+                    continue;
+                }
+                if (fields >> extra) {
+                    std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Line " << lineNumber << " of " << argv[2] << " has extra fields and was skipped." << std::endl;
+                    continue;
+                }
+                requests.push_back(request);
+                requestLines.push_back(lineNumber);
+            }
+
+            JournalTransaction transaction(scheduler, APPS_FILENAME);
+            std::vector<Appointment> scheduled;
+            std::vector<BookingStatus> results = scheduler.scheduleBatch(requests, &scheduled);
+            std::ostringstream report;
+            for (size_t i = 0; i < results.size(); ++i) {
+                const BookingRequest& r = requests[i];
+                report << (results[i] == BookingStatus::Accepted ? GREEN + "ACCEPTED" : RED + "REJECTED") << RESET
+                       << " line " << requestLines[i] << ": " << r.day << "/" << r.month << "/" << r.year << " "
+                       << std::setfill('0') << std::setw(2) << r.hour << ":" << std::setw(2) << r.minute << std::setfill(' ')
+                       << " op " << r.operation_number;
+                if (results[i] != BookingStatus::Accepted) {
+                    report << " (" << describeBookingStatus(results[i]) << ")";
+                }
+                report << '\n';
+            }
+            std::cout << report.str();
+            std::cout << BOLD << scheduled.size() << " of " << results.size() << " requests scheduled." << RESET << std::endl;
+
+            if (!scheduled.empty()) {
+                if (!scheduler.appendAppointments(APPS_FILENAME, scheduled)) {
+                    std::cerr << RED << BOLD << "CRITICAL WARNING: " << RESET << "Appointments were added to memory, but automatic saving to file "
+                              << APPS_FILENAME << RED << " FAILED!" << RESET << std::endl;
+                    std::cerr << YELLOW << "Please contact the administrator." << RESET << std::endl;
+                    return 2;
+                } else if (scheduler.journalSize() >= JOURNAL_CHECKPOINT_RECORDS) {
+                    scheduler.checkpointAppointments(APPS_FILENAME);
+                }
+            }
+        } else if (command == "schedule_series") {
+            if (argc != 10) { printUserUsage(); return 1; }
+            BookingRequest first;
+            first.day = std::stoi(argv[2]);
+            first.month = std::stoi(argv[3]);
+            first.year = std::stoi(argv[4]);
+            first.hour = std::stoi(argv[5]);
+            first.minute = std::stoi(argv[6]);
+            first.operation_number = std::stoi(argv[7]);
+            RecurrenceRule rule;
+            std::string error;
+            if (!parseRecurrenceRule(argv[8], argv[9], rule, error)) {
+                std::cerr << RED << BOLD << "Error: " << RESET << error << std::endl;
+                return 1;
+            }
+
+            JournalTransaction transaction(scheduler, APPS_FILENAME);
+            std::vector<Appointment> scheduled;
+            if (scheduler.scheduleSeries(first, rule, &scheduled)) {
+                // The whole series goes to the journal in a single write
+                if (!scheduler.appendAppointments(APPS_FILENAME, scheduled)) {
+                    std::cerr << RED << BOLD << "CRITICAL WARNING: " << RESET << "Appointments were added to memory, but automatic saving to file "
+                              << APPS_FILENAME << RED << " FAILED!" << RESET << std::endl;
+                    std::cerr << YELLOW << "Please contact the administrator." << RESET << std::endl;
+                    return 2;
+                } else if (scheduler.journalSize() >= JOURNAL_CHECKPOINT_RECORDS) {
+                    scheduler.checkpointAppointments(APPS_FILENAME);
+                }
+            }
+        } else if (command == "plan") {
+            if (argc != 3 && argc != 4) { printUserUsage(); return 1; }
+            PlanObjective objective = PlanObjective::Requests;
+            if (argc == 4 && !parsePlanObjective(argv[3], objective)) {
+                std::cerr << RED << BOLD << "Error: " << RESET << "Unknown objective '" << argv[3] << "' (expected requests or minutes)." << std::endl;
+                return 1;
+            }
+            std::ifstream queueFile(argv[2]);
+            if (!queueFile) {
+                std::cerr << RED << BOLD << "Error: " << RESET << "Could not open waiting list: " << argv[2] << std::endl;
+                return 1;
+            }
+
+            std::vector<PlanRequest> queue;
+            std::vector<int> queueLines;
+            std::string line;
+            int lineNumber = 0;
+            while (std::getline(queueFile, line)) {
+                ++lineNumber;
+                if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+                PlanRequest request;
+                std::string error;
+                if (!parsePlanRequest(line, request, error)) {
+                    std::cerr << YELLOW << BOLD << "Warning: " << RESET << "Line " << lineNumber << " of " << argv[2] << " was skipped: " << error << "." << std::endl;
+                    continue;
+                }
+                queue.push_back(request);
+                queueLines.push_back(lineNumber);
+            }
+
+            JournalTransaction transaction(scheduler, APPS_FILENAME);
+            std::vector<Appointment> planned;
+            std::vector<BookingStatus> results = scheduler.planRequests(queue, objective, &planned);
+            std::vector<Appointment> scheduled;
+            long long bookedMinutes = 0;
+            std::ostringstream report;
+            for (size_t i = 0; i < results.size(); ++i) {
+                report << (results[i] == BookingStatus::Accepted ? GREEN + "PLANNED" : RED + "UNPLANNED") << RESET
+                       << " line " << queueLines[i] << ": ";
+                if (results[i] == BookingStatus::Accepted) {
+                    const Appointment& app = planned[i];
+                    int day, month, year;
+                    app.date(day, month, year);
+                    report << scheduler.operationOf(app).name << " on " << std::setfill('0') << std::setw(2) << day << "/" << std::setw(2) << month << "/" << year
+                           << " at " << std::setw(2) << app.hour() << ":" << std::setw(2) << app.minute() << std::setfill(' ');
+                    if (scheduler.resources.size() > 1) report << " with " << scheduler.resources[app.resourceId].name;
+                    scheduled.push_back(app);
+                    bookedMinutes += app.duration;
                 } else {
-                    // std::cout << "Appointment was saved automatically." << std::endl; // Message already clear from scheduleAppointment
+                    report << queue[i].operation << " (" << describeBookingStatus(results[i]) << ")";
+                }
+                report << '\n';
+            }
+            std::cout << report.str();
+            std::cout << BOLD << scheduled.size() << " of " << results.size() << " requests planned, " << bookedMinutes << " minutes booked." << RESET << std::endl;
+
+            if (!scheduled.empty()) {
+                if (!scheduler.appendAppointments(APPS_FILENAME, scheduled)) {
+                    std::cerr << RED << BOLD << "CRITICAL WARNING: " << RESET << "Appointments were added to memory, but automatic saving to file "
+                              << APPS_FILENAME << RED << " FAILED!" << RESET << std::endl;
+                    std::cerr << YELLOW << "Please contact the administrator." << RESET << std::endl;
+                    return 2;
+                } else if (scheduler.journalSize() >= JOURNAL_CHECKPOINT_RECORDS) {
+                    scheduler.checkpointAppointments(APPS_FILENAME);
+                }
+            }
+        } else if (command == "cancel" || command == "reschedule") {
+            const int timeArgs = command == "cancel" ? 5 : 10;
+            if (argc != 2 + timeArgs && argc != 3 + timeArgs) { printUserUsage(); return 1; }
+            int fields[10];
+            for (int i = 0; i < timeArgs; ++i) {
+                fields[i] = std::stoi(argv[2 + i]);
+            }
+            int resourceId = -1; // Any chair or dentist; needed only when several appointments start at that time
+            if (argc == 3 + timeArgs) {
+                resourceId = scheduler.findResourceId(argv[2 + timeArgs]);
+                if (resourceId < 0) {
+                    std::cerr << RED << BOLD << "Error: " << RESET << "Unknown chair or dentist '" << argv[2 + timeArgs] << "'." << std::endl;
+                    return 1;
                 }
             }
+
+            // Only a tombstone (and the moved record) is appended to the journal
+            JournalTransaction transaction(scheduler, APPS_FILENAME);
+            Appointment previous, moved;
+            bool changed = command == "cancel"
+                ? scheduler.cancelAppointment(fields[0], fields[1], fields[2], fields[3], fields[4], resourceId, &previous)
+                : scheduler.rescheduleAppointment(fields[0], fields[1], fields[2], fields[3], fields[4],
+                                                  fields[5], fields[6], fields[7], fields[8], fields[9], resourceId, &previous, &moved);
+            if (!changed) {
+                return 1;
+            }
+            if (!scheduler.appendCancellation(APPS_FILENAME, previous, command == "cancel" ? nullptr : &moved)) {
+                std::cerr << RED << BOLD << "CRITICAL WARNING: " << RESET << "Appointment was changed in memory, but automatic saving to file "
+                          << APPS_FILENAME << RED << " FAILED!" << RESET << std::endl;
+                std::cerr << YELLOW << "Please contact the administrator." << RESET << std::endl;
+                return 2;
+            } else if (scheduler.journalSize() >= JOURNAL_CHECKPOINT_RECORDS) {
+                scheduler.checkpointAppointments(APPS_FILENAME);
+            }
+        } else if (command == "find_slots") {
+            if (argc != 5 && argc != 6) { printUserUsage(); return 1; }
+            int op_num = std::stoi(argv[2]);
+            int fromDay, fromMonth, fromYear, toDay, toMonth, toYear;
+            if (!parseDate(argv[3], fromDay, fromMonth, fromYear) || !parseDate(argv[4], toDay, toMonth, toYear)) {
+                std::cerr << RED << BOLD << "Error: " << RESET << "Dates must be valid and written as day/month/year." << std::endl;
+                return 1;
+            }
+            int count = argc == 6 ? std::stoi(argv[5]) : 10;
+            if (op_num <= 0 || static_cast<size_t>(op_num) > scheduler.operations.size() || count <= 0) {
+                std::cerr << RED << BOLD << "Error: " << RESET << "Invalid operation number or count." << std::endl;
+                scheduler.displayOperations();
+                return 1;
+            }
+
+            const Operation& op = scheduler.operations[op_num - 1];
+            std::vector<BookingRequest> slots = scheduler.findFreeSlots(op_num, daysFromCivil(fromDay, fromMonth, fromYear),
+                                                                        daysFromCivil(toDay, toMonth, toYear), static_cast<size_t>(count));
+            if (slots.empty()) {
+                std::cout << YELLOW << BOLD << "No free slot for '" << op.name << "' between " << argv[3] << " and " << argv[4] << "." << RESET << std::endl;
+            } else {
+                std::cout << CYAN << BOLD << "Free slots for '" << op.name << "' (" << op.duration << " min):" << RESET << '\n';
+                for (const auto& slot : slots) {
+                    int end = slot.hour * 60 + slot.minute + op.duration;
+                    std::cout << GREEN << std::setfill('0') << std::setw(2) << slot.day << "/" << std::setw(2) << slot.month << "/" << slot.year
+                              << "  " << std::setw(2) << slot.hour << ":" << std::setw(2) << slot.minute
+                              << " - " << std::setw(2) << end / 60 << ":" << std::setw(2) << end % 60 << RESET << '\n';
+                }
+                std::cout << std::setfill(' ') << std::flush;
+            }
         } else if (command == "view_history") {
-            if (argc != 2) { printUserUsage(); return 1; }
-            scheduler.displayAppointmentHistory();
+            HistoryQuery query;
+            std::string error;
+            if (!parseHistoryQuery(std::vector<std::string>(argv + 2, argv + argc), query, error)) {
+                std::cerr << RED << BOLD << "Error: " << RESET << error << std::endl;
+                printUserUsage();
+                return 1;
+            }
+            scheduler.loadArchivedRange(query.fromDay, query.toDay);
+            if (!scheduler.displayAppointmentHistory(query)) {
+                return 1;
+            }
         } else {
             std::cerr << RED << BOLD << "Error: " << RESET << "Unknown user command '" << command << "'" << std::endl;
             printUserUsage();